@@ -13,3 +13,4 @@ const Color Color::Black = Color(0.0f, 0.0f, 0.0f, 1.0f);
 const Color Color::Red = Color(1.0f, 0.0f, 0.0f, 1.0f);
 const Color Color::Green = Color(0.0f, 1.0f, 0.0f, 1.0f);
 const Color Color::Blue = Color(0.0f, 0.0f, 1.0f, 1.0f);
+const Color Color::Transparent = Color(0.0f, 0.0f, 0.0f, 0.0f);
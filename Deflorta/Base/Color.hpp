@@ -25,4 +25,5 @@ struct Color
     static const Color Red;
     static const Color Green;
     static const Color Blue;
+    static const Color Transparent;
 };
@@ -7,8 +7,11 @@
 #include "Discord.hpp"
 #include "SaveManager.hpp"
 #include "Window.hpp"
+#include "../Render/GlobalAtlas.hpp"
 #include "../Render/Renderer.hpp"
 #include "../Resource/AudioManager.hpp"
+#include "../Resource/LoadQueue.hpp"
+#include "../Resource/ResourceArchive.hpp"
 #include "../Resource/ResourceManager.hpp"
 #include "../Resource/Foley.hpp"
 
@@ -22,10 +25,19 @@ void Game::Initialize()
 
     if (!AudioManager::Initialize())
         running_ = false;
-    if (!Renderer::Initialize(Window::GetNativeWindowHandle()))
+    const auto backendType = SaveManager::GetString("renderBackend", "d2d") == "software"
+                                 ? RenderBackendType::Software
+                                 : RenderBackendType::Direct2D;
+    if (!Renderer::Initialize(Window::GetNativeWindowHandle(), backendType,
+                              SaveManager::GetBool("renderThread", true)))
         running_ = false;
+    Renderer::SetTextureBatching(SaveManager::GetBool("textureBatching", true));
+    Renderer::SetRenderScale(SaveManager::GetFloat("renderScale", 1.0f));
+    Renderer::SetDynamicResolution(SaveManager::GetBool("dynamicResolution", false));
 
     ResourceManager::SetRenderBackend(Renderer::GetRenderBackend());
+    ResourceManager::SetGenerateMips(SaveManager::GetBool("textureMips", true));
+    GlobalAtlas::SetEnabled(SaveManager::GetBool("globalAtlas", true));
 
     if (!ResourceManager::LoadManifest())
         running_ = false;
@@ -37,10 +49,12 @@ void Game::Initialize()
 
 void Game::Uninitialize()
 {
+    LoadQueue::Shutdown();
     SaveManager::Uninitialize();
     Discord::Shutdown();
     AudioManager::Uninitialize();
     Renderer::Cleanup();
+    ResourceArchive::Close();
 }
 
 void Game::Run()
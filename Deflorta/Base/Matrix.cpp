@@ -1,52 +1,86 @@
 #include "Matrix.hpp"
 
-#include <glm/gtc/matrix_transform.hpp>
+#include <glm/trigonometric.hpp>
+
+#include <cmath>
+
+Affine2D Affine2D::Inverse() const
+{
+    const float det = Determinant();
+    if (det == 0.0f) return {};
+
+    const float invDet = 1.0f / det;
+    return {
+        m22 * invDet, -m12 * invDet,
+        -m21 * invDet, m11 * invDet,
+        (m21 * dy - m22 * dx) * invDet, (m12 * dx - m11 * dy) * invDet
+    };
+}
+
+Affine2D operator*(const Affine2D& outer, const Affine2D& inner)
+{
+    return {
+        inner.m11 * outer.m11 + inner.m12 * outer.m21,
+        inner.m11 * outer.m12 + inner.m12 * outer.m22,
+        inner.m21 * outer.m11 + inner.m22 * outer.m21,
+        inner.m21 * outer.m12 + inner.m22 * outer.m22,
+        inner.dx * outer.m11 + inner.dy * outer.m21 + outer.dx,
+        inner.dx * outer.m12 + inner.dy * outer.m22 + outer.dy
+    };
+}
 
 namespace MatrixHelper
 {
-    glm::mat3 Identity()
+    Affine2D Identity()
     {
-        return {1.0f};
+        return {};
     }
 
-    glm::mat3 Translation(glm::vec2 vec)
+    Affine2D Translation(glm::vec2 vec)
     {
-        glm::mat3 mat(1.0f);
-        mat[2][0] = vec.x;
-        mat[2][1] = vec.y;
-        return mat;
+        return {1.0f, 0.0f, 0.0f, 1.0f, vec.x, vec.y};
     }
 
-    glm::mat3 Scale(glm::vec2 scale)
+    Affine2D Scale(glm::vec2 scale)
     {
-        glm::mat3 mat(1.0f);
-        mat[0][0] = scale.x;
-        mat[1][1] = scale.y;
-        return mat;
+        return {scale.x, 0.0f, 0.0f, scale.y, 0.0f, 0.0f};
     }
 
-    glm::mat3 Rotation(float angleInDegrees)
+    Affine2D Rotation(float angleInDegrees)
     {
         const float rad = glm::radians(angleInDegrees);
         const float c = std::cos(rad);
         const float s = std::sin(rad);
-        glm::mat3 mat(1.0f);
-        mat[0][0] = c;
-        mat[0][1] = s;
-        mat[1][0] = -s;
-        mat[1][1] = c;
-        return mat;
+        return {c, s, -s, c, 0.0f, 0.0f};
+    }
+
+    Affine2D CreateMatrix(float m11, float m12, float m21, float m22, float dx, float dy)
+    {
+        return {m11, m12, m21, m22, dx, dy};
     }
 
-    glm::mat3 CreateMatrix(float m11, float m12, float m21, float m22, float dx, float dy)
+    Affine2D Compose(glm::vec2 position, glm::vec2 scale, float angleInDegrees, glm::vec2 pivot)
     {
-        glm::mat3 mat(1.0f);
-        mat[0][0] = m11;
-        mat[0][1] = m12;
-        mat[1][0] = m21;
-        mat[1][1] = m22;
-        mat[2][0] = dx;
-        mat[2][1] = dy;
-        return mat;
+        // Translation(position + pivot) * Rotation * Scale * Translation(-pivot), expanded.
+        float c = 1.0f;
+        float s = 0.0f;
+        if (angleInDegrees != 0.0f)
+        {
+            const float rad = glm::radians(angleInDegrees);
+            c = std::cos(rad);
+            s = std::sin(rad);
+        }
+
+        const float m11 = scale.x * c;
+        const float m12 = scale.x * s;
+        const float m21 = -scale.y * s;
+        const float m22 = scale.y * c;
+
+        return {
+            m11, m12,
+            m21, m22,
+            position.x + pivot.x - pivot.x * m11 - pivot.y * m21,
+            position.y + pivot.y - pivot.x * m12 - pivot.y * m22
+        };
     }
 }
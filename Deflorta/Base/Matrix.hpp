@@ -1,12 +1,34 @@
 #pragma once
 
-#include <glm/mat3x3.hpp>
+#include <glm/vec2.hpp>
+
+struct Affine2D
+{
+    float m11 = 1.0f;
+    float m12 = 0.0f;
+    float m21 = 0.0f;
+    float m22 = 1.0f;
+    float dx = 0.0f;
+    float dy = 0.0f;
+
+    [[nodiscard]] glm::vec2 TransformPoint(const glm::vec2& point) const
+    {
+        return {point.x * m11 + point.y * m21 + dx, point.x * m12 + point.y * m22 + dy};
+    }
+
+    [[nodiscard]] float Determinant() const { return m11 * m22 - m12 * m21; }
+    [[nodiscard]] Affine2D Inverse() const;
+
+    friend Affine2D operator*(const Affine2D& outer, const Affine2D& inner);
+    friend bool operator==(const Affine2D& a, const Affine2D& b) = default;
+};
 
 namespace MatrixHelper
 {
-    glm::mat3 Identity();
-    glm::mat3 Translation(glm::vec2 vec);
-    glm::mat3 Scale(glm::vec2 scale);
-    glm::mat3 Rotation(float angleInDegrees);
-    glm::mat3 CreateMatrix(float m11, float m12, float m21, float m22, float dx, float dy);
+    Affine2D Identity();
+    Affine2D Translation(glm::vec2 vec);
+    Affine2D Scale(glm::vec2 scale);
+    Affine2D Rotation(float angleInDegrees);
+    Affine2D CreateMatrix(float m11, float m12, float m21, float m22, float dx, float dy);
+    Affine2D Compose(glm::vec2 position, glm::vec2 scale, float angleInDegrees, glm::vec2 pivot);
 }
@@ -0,0 +1,137 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace
+{
+    thread_local bool t_isWorker = false;
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        const uint32_t hw = std::max(1u, std::thread::hardware_concurrency());
+        threadCount = std::max(1u, hw - 1);
+    }
+
+    workers_.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        workers_.emplace_back([this] { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::Shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+bool ThreadPool::IsWorkerThread()
+{
+    return t_isWorker;
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+    if (count == 0) return;
+    if (count == 1 || workers_.empty())
+    {
+        for (size_t i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    // Helpers that start after the caller has drained the range never touch fn, so the
+    // caller only waits for helpers that actually began; nested calls cannot deadlock.
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::atomic<size_t> next = 0;
+        size_t active = 0;
+        bool closed = false;
+    };
+
+    const auto state = std::make_shared<State>();
+    const auto* body = &fn;
+
+    auto drain = [state, body, count]
+    {
+        for (size_t i = state->next.fetch_add(1); i < count; i = state->next.fetch_add(1))
+            (*body)(i);
+    };
+
+    const size_t helperCount = std::min(count - 1, workers_.size());
+    for (size_t h = 0; h < helperCount; ++h)
+    {
+        Submit([state, drain]
+        {
+            {
+                std::lock_guard lock(state->mutex);
+                if (state->closed) return;
+                ++state->active;
+            }
+
+            drain();
+
+            {
+                std::lock_guard lock(state->mutex);
+                --state->active;
+            }
+            state->cv.notify_all();
+        });
+    }
+
+    drain();
+
+    std::unique_lock lock(state->mutex);
+    state->closed = true;
+    state->cv.wait(lock, [&state] { return state->active == 0; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    t_isWorker = true;
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (stopping_ && tasks_.empty()) return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool final
+{
+public:
+    explicit ThreadPool(uint32_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    static ThreadPool& Shared();
+    static bool IsWorkerThread();
+
+    void Submit(std::function<void()> task);
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    [[nodiscard]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
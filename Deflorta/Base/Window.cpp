@@ -1,5 +1,6 @@
 #include "Window.hpp"
 #include "Input.hpp"
+#include "../Utils.hpp"
 #include "../Render/Renderer.hpp"
 
 #include <GLFW/glfw3.h>
@@ -9,6 +10,9 @@
 #include <GLFW/glfw3native.h>
 #endif
 
+#include <chrono>
+#include <filesystem>
+#include <format>
 #include <iostream>
 
 GLFWwindow* Window::window_ = nullptr;
@@ -137,6 +141,17 @@ static MouseButton GlfwMouseButtonToMouseButton(int glfwButton)
     return static_cast<MouseButton>(glfwButton);
 }
 
+static std::string NextCapturePath()
+{
+    const auto directory = std::filesystem::path(Utils::GetExecutableDir()) / "captures";
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return (directory / std::format("frame-{}.dfcp", stamp)).string();
+}
+
 void Window::KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     const Key keyEnum = GlfwKeyToKey(key);
@@ -148,6 +163,18 @@ void Window::KeyCallback(GLFWwindow* window, int key, int scancode, int action,
         {
             Renderer::ToggleFPS();
         }
+        else if (keyEnum == Key::F2)
+        {
+            Renderer::ToggleStats();
+        }
+        else if (keyEnum == Key::F4)
+        {
+            Renderer::ToggleOverdraw();
+        }
+        else if (keyEnum == Key::F12)
+        {
+            Renderer::RequestCapture(NextCapturePath(), mods & GLFW_MOD_SHIFT ? 60 : 1);
+        }
     }
     else if (action == GLFW_RELEASE)
     {
@@ -1,9 +1,22 @@
 #include <windows.h>
+#include <shellapi.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cwchar>
+#include <filesystem>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "Base/Game.hpp"
 #include "Base/Window.hpp"
+#include "Render/DrawCapture.hpp"
+#include "Render/Renderer.hpp"
+#include "Resource/ResourceManager.hpp"
 #include "Scene/LoadScene.hpp"
 
 #ifdef _WIN32
@@ -13,8 +26,149 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 }
 #endif
 
+namespace
+{
+    std::vector<std::wstring> GetArguments()
+    {
+        int argc = 0;
+        LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+        std::vector<std::wstring> args;
+        for (int i = 1; argv && i < argc; ++i)
+            args.emplace_back(argv[i]);
+        LocalFree(argv);
+        return args;
+    }
+
+    bool ParsePositiveInt(const std::wstring& text, int& outValue)
+    {
+        wchar_t* end = nullptr;
+        errno = 0;
+        const long value = std::wcstol(text.c_str(), &end, 10);
+        if (end == text.c_str() || *end != L'\0' || errno == ERANGE || value < 1 || value > INT_MAX)
+            return false;
+        outValue = static_cast<int>(value);
+        return true;
+    }
+
+    int RunReplay(const std::vector<std::wstring>& args)
+    {
+        if (AttachConsole(ATTACH_PARENT_PROCESS))
+        {
+            FILE* stream = nullptr;
+            freopen_s(&stream, "CONOUT$", "w", stdout);
+            freopen_s(&stream, "CONOUT$", "w", stderr);
+        }
+
+        std::string capturePath;
+        bool software = true;
+        int iterations = 100;
+        bool batching = true;
+        bool overdraw = false;
+        for (size_t i = 0; i < args.size(); ++i)
+        {
+            if (args[i] == L"--replay" && i + 1 < args.size())
+                capturePath = std::filesystem::path(args[++i]).string();
+            else if (args[i] == L"--backend" && i + 1 < args.size())
+                software = args[++i] != L"d2d";
+            else if (args[i] == L"--iterations" && i + 1 < args.size())
+            {
+                if (!ParsePositiveInt(args[++i], iterations))
+                {
+                    std::cerr << "Invalid --iterations value; expected a positive integer\n"
+                        << "Usage: Deflorta --replay <capture> [--backend software|d2d] [--iterations N]"
+                        << " [--no-batching] [--overdraw]\n";
+                    return 1;
+                }
+            }
+            else if (args[i] == L"--no-batching")
+                batching = false;
+            else if (args[i] == L"--overdraw")
+                overdraw = true;
+        }
+
+        void* windowHandle = nullptr;
+        if (!software)
+        {
+            if (!Window::Create(1280, 720, "Deflorta Replay"))
+            {
+                std::cerr << "Failed to create window\n";
+                return 1;
+            }
+            windowHandle = Window::GetNativeWindowHandle();
+        }
+
+        const auto backendType = software ? RenderBackendType::Software : RenderBackendType::Direct2D;
+        if (!Renderer::Initialize(windowHandle, backendType, false))
+        {
+            std::cerr << "Failed to initialize renderer\n";
+            return 1;
+        }
+        Renderer::SetTextureBatching(batching);
+        Renderer::SetOverdrawMode(overdraw);
+
+        ResourceManager::SetRenderBackend(Renderer::GetRenderBackend());
+        if (!ResourceManager::LoadManifest())
+            return 1;
+
+        DrawCapture capture;
+        if (!capture.Load(capturePath, Renderer::GetRenderBackend(), DrawCapture::ResolveResourceTexture,
+                          DrawCapture::ResolveAtlasEntry))
+            return 1;
+
+        auto& frames = capture.GetFrames();
+        if (frames.empty())
+        {
+            std::cerr << "Capture contains no frames\n";
+            return 1;
+        }
+
+        for (auto& frame : frames)
+            Renderer::ReplayFrame(frame);
+        const RenderStats stats = Renderer::GetStats();
+
+        std::vector<double> frameTimes;
+        frameTimes.reserve(static_cast<size_t>(iterations) * frames.size());
+        for (int i = 0; i < iterations; ++i)
+        {
+            for (auto& frame : frames)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                Renderer::ReplayFrame(frame);
+                const auto end = std::chrono::steady_clock::now();
+                frameTimes.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            }
+        }
+
+        std::ranges::sort(frameTimes);
+        double total = 0.0;
+        for (const double t : frameTimes)
+            total += t;
+
+        std::cout << "Replayed " << frames.size() << " frame(s) x " << iterations << " on "
+            << (software ? "software" : "d2d") << " backend\n"
+            << "  avg " << total / static_cast<double>(frameTimes.size()) << " ms"
+            << "  p50 " << frameTimes[frameTimes.size() / 2] << " ms"
+            << "  p99 " << frameTimes[frameTimes.size() * 99 / 100] << " ms"
+            << "  max " << frameTimes.back() << " ms\n"
+            << "  texture switches (last frame) " << stats.textureSwitchesUnbatched << " -> "
+            << stats.textureSwitches << "\n";
+        if (overdraw)
+            std::cout << "  overdraw (last frame) " << stats.overdrawFactor << "x, max " << stats.maxOverdraw << "\n";
+
+        frames.clear();
+        Renderer::Cleanup();
+        if (!software)
+            Window::Destroy();
+        return 0;
+    }
+}
+
 int APIENTRY wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR, int nCmdShow)
 {
+    const auto args = GetArguments();
+    if (std::ranges::find(args, L"--replay") != args.end())
+        return RunReplay(args);
+
     if (!Window::Create(1280, 720, "Deflorta"))
     {
         std::cerr << "Failed to create window\n";
@@ -5,6 +5,8 @@
 #include "../Render/Renderer.hpp"
 #include "../Resource/ResourceManager.hpp"
 
+#include <algorithm>
+
 Fog::Fog(int rowCount, int maxColumns)
     : GameObject(GameObjectTag::Ambient), rowCount_(rowCount), maxColumns_(maxColumns)
 {
@@ -24,6 +26,19 @@ void Fog::Update()
 }
 
 void Fog::Render()
+{
+    if (IsMoving())
+    {
+        EnqueuePieces();
+        return;
+    }
+
+    if (fogLayer_.IsEmpty())
+        fogLayer_.Record([this] { EnqueuePieces(); });
+    fogLayer_.Render();
+}
+
+void Fog::EnqueuePieces() const
 {
     for (const auto& piece : fogPieces_)
     {
@@ -34,8 +49,17 @@ void Fog::Render()
     }
 }
 
+bool Fog::IsMoving() const
+{
+    return std::ranges::any_of(fogPieces_, [](const FogPiece& piece)
+    {
+        return piece.tween && piece.tween->IsActive();
+    });
+}
+
 void Fog::MoveFog(float targetX, float duration)
 {
+    fogLayer_.Clear();
     for (auto& piece : fogPieces_)
     {
         const float startX = piece.transform.position.x;
@@ -66,6 +90,7 @@ std::shared_ptr<ITexture> Fog::GetRandomFogTexture()
 
 void Fog::GenerateFogPieces()
 {
+    fogLayer_.Clear();
     fogPieces_.clear();
     const int totalRows = rowCount_ + 2;
     fogPieces_.reserve(totalRows * maxColumns_);
@@ -4,6 +4,7 @@
 #include "../Base/Transform.hpp"
 #include "../Base/Tween.hpp"
 #include "../Render/IRenderBackend.hpp"
+#include "../Render/StaticLayer.hpp"
 
 #include <memory>
 #include <vector>
@@ -29,9 +30,12 @@ public:
 
 private:
     std::vector<FogPiece> fogPieces_;
+    StaticLayer fogLayer_;
     int rowCount_;
     int maxColumns_;
 
     static std::shared_ptr<ITexture> GetRandomFogTexture();
     void GenerateFogPieces();
+    void EnqueuePieces() const;
+    [[nodiscard]] bool IsMoving() const;
 };
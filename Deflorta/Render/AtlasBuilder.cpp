@@ -1,13 +1,17 @@
 #include "AtlasBuilder.hpp"
 
+#include <emmintrin.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
 #include <algorithm>
+#include <bit>
+#include <cstring>
 #include <iostream>
 #include <ranges>
 
 #include "../Base/Random.hpp"
+#include "../Utils.hpp"
 
 bool TextureAtlas::Save(const std::string& filePath) const
 {
@@ -29,7 +33,38 @@ bool TextureAtlas::Save(const std::string& filePath) const
     return result != 0;
 }
 
-void AtlasBuilder::AddImage(const std::string& id, const PixelData& pixelData)
+PixelData TextureAtlas::ExtractRegion(const AtlasRegion& region) const
+{
+    PixelData result;
+    result.width = region.width;
+    result.height = region.height;
+    result.pitch = region.width * 4;
+    result.pixels.resize(static_cast<size_t>(result.pitch) * region.height);
+
+    const auto* src = reinterpret_cast<const uint32_t*>(atlasData.pixels.data());
+    auto* dst = reinterpret_cast<uint32_t*>(result.pixels.data());
+
+    for (uint32_t v = 0; v < region.height; ++v)
+    {
+        if (!region.rotated)
+        {
+            std::memcpy(dst + static_cast<size_t>(v) * region.width,
+                        src + static_cast<size_t>(region.y + v) * atlasData.width + region.x,
+                        region.width * 4);
+            continue;
+        }
+
+        // Inverse of the packing rotation: sprite (u, v) sits at (height - 1 - v, u) in the block.
+        const uint32_t column = region.x + region.height - 1 - v;
+        uint32_t* dstRow = dst + static_cast<size_t>(v) * region.width;
+        for (uint32_t u = 0; u < region.width; ++u)
+            dstRow[u] = src[static_cast<size_t>(region.y + u) * atlasData.width + column];
+    }
+
+    return result;
+}
+
+void AtlasBuilder::AddImage(const std::string& id, const PixelData& pixelData, bool trimTransparent)
 {
     if (pixelData.width == 0 || pixelData.height == 0 || pixelData.pixels.empty())
     {
@@ -37,50 +72,138 @@ void AtlasBuilder::AddImage(const std::string& id, const PixelData& pixelData)
         return;
     }
 
-    images_.push_back({.id = id, .data = pixelData});
+    ImageEntry entry{.id = id, .sourceWidth = pixelData.width, .sourceHeight = pixelData.height};
+    if (!trimTransparent || !TrimTransparent(pixelData, entry.data, entry.trimX, entry.trimY))
+        entry.data = pixelData;
+
+    // Identical content (after trimming) reuses the earlier image's region with its own trim offset.
+    entry.contentHash = HashContent(entry.data);
+    if (const auto it = contentIndex_.find(entry.contentHash); it != contentIndex_.end())
+    {
+        const ImageEntry& source = images_[it->second];
+        if (source.data.width == entry.data.width && source.data.height == entry.data.height &&
+            source.data.pixels == entry.data.pixels)
+        {
+            aliases_.push_back({
+                .id = id, .sourceId = source.id, .trimX = entry.trimX, .trimY = entry.trimY,
+                .sourceWidth = entry.sourceWidth, .sourceHeight = entry.sourceHeight
+            });
+            dedupedBytes_ += entry.data.pixels.size();
+            return;
+        }
+    }
+
+    contentIndex_.emplace(entry.contentHash, images_.size());
+    images_.push_back(std::move(entry));
+}
+
+uint64_t AtlasBuilder::HashContent(const PixelData& data)
+{
+    uint64_t hash = Utils::HashBytes(&data.width, sizeof(data.width));
+    hash = Utils::HashBytes(&data.height, sizeof(data.height), hash);
+    return Utils::HashBytes(data.pixels.data(), data.pixels.size(), hash);
 }
 
 void AtlasBuilder::Clear()
 {
     images_.clear();
+    aliases_.clear();
+    contentIndex_.clear();
+    dedupedBytes_ = 0;
 }
 
-AtlasBuilder::PackNode* AtlasBuilder::FindNode(PackNode* root, uint32_t width, uint32_t height)
+namespace
 {
-    if (!root) return nullptr;
+    const __m128i kAlphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
 
-    if (root->used)
+    // Lane bits of the four pixels at row[x] whose alpha is non-zero.
+    unsigned OpaqueLanes(const uint32_t* row, uint32_t x)
     {
-        if (PackNode* newNode = FindNode(root->right, width, height)) return newNode;
-        return FindNode(root->down, width, height);
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        const __m128i clear = _mm_cmpeq_epi32(_mm_and_si128(pixels, kAlphaMask), _mm_setzero_si128());
+        return ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(clear))) & 0xFu;
     }
 
-    if (width <= root->width && height <= root->height)
+    // First pixel in [begin, end) with non-zero alpha, or end.
+    uint32_t FirstOpaque(const uint32_t* row, uint32_t begin, uint32_t end)
     {
-        return root;
+        uint32_t x = begin;
+        for (; x + 4 <= end; x += 4)
+        {
+            if (const unsigned lanes = OpaqueLanes(row, x))
+                return x + static_cast<uint32_t>(std::countr_zero(lanes));
+        }
+        for (; x < end; ++x)
+        {
+            if (row[x] & 0xFF000000u) return x;
+        }
+        return end;
     }
 
-    return nullptr;
+    // One past the last pixel in [begin, end) with non-zero alpha, or begin.
+    uint32_t LastOpaque(const uint32_t* row, uint32_t begin, uint32_t end)
+    {
+        uint32_t x = end;
+        for (; x >= begin + 4; x -= 4)
+        {
+            if (const unsigned lanes = OpaqueLanes(row, x - 4))
+                return x - 4 + static_cast<uint32_t>(std::bit_width(lanes));
+        }
+        for (; x > begin; --x)
+        {
+            if (row[x - 1] & 0xFF000000u) return x;
+        }
+        return begin;
+    }
 }
 
-AtlasBuilder::PackNode* AtlasBuilder::SplitNode(PackNode* node, uint32_t width, uint32_t height)
+bool AtlasBuilder::TrimTransparent(const PixelData& src, PixelData& outTrimmed, uint32_t& outX, uint32_t& outY)
 {
-    if (!node) return nullptr;
-
-    node->used = true;
-    node->down = new PackNode();
-    node->down->x = node->x;
-    node->down->y = node->y + height;
-    node->down->width = node->width;
-    node->down->height = node->height - height;
-
-    node->right = new PackNode();
-    node->right->x = node->x + width;
-    node->right->y = node->y;
-    node->right->width = node->width - width;
-    node->right->height = height;
-
-    return node;
+    const uint32_t pitch = src.pitch ? src.pitch : src.width * 4;
+
+    uint32_t minX = src.width, maxX = 0;
+    uint32_t minY = src.height, maxY = 0;
+
+    for (uint32_t y = 0; y < src.height; ++y)
+    {
+        const auto* row = reinterpret_cast<const uint32_t*>(src.pixels.data() + static_cast<size_t>(y) * pitch);
+
+        const uint32_t first = FirstOpaque(row, 0, src.width);
+        if (first == src.width) continue;
+
+        // Only the part right of the current bound can still widen it.
+        minX = std::min(minX, first);
+        maxX = std::max(maxX, LastOpaque(row, std::max(first, maxX), src.width));
+        minY = std::min(minY, y);
+        maxY = y + 1;
+    }
+
+    if (minY == src.height)
+    {
+        // Fully transparent: keep a single clear texel so the part still resolves.
+        minX = minY = 0;
+        maxX = maxY = 1;
+    }
+    else if (minX == 0 && minY == 0 && maxX == src.width && maxY == src.height)
+    {
+        return false;
+    }
+
+    outTrimmed.width = maxX - minX;
+    outTrimmed.height = maxY - minY;
+    outTrimmed.pitch = outTrimmed.width * 4;
+    outTrimmed.pixels.resize(static_cast<size_t>(outTrimmed.pitch) * outTrimmed.height);
+
+    for (uint32_t y = 0; y < outTrimmed.height; ++y)
+    {
+        std::memcpy(outTrimmed.pixels.data() + static_cast<size_t>(y) * outTrimmed.pitch,
+                    src.pixels.data() + static_cast<size_t>(minY + y) * pitch + minX * 4,
+                    outTrimmed.pitch);
+    }
+
+    outX = minX;
+    outY = minY;
+    return true;
 }
 
 void AtlasBuilder::CopyImageToAtlas(const PixelData& src, PixelData& dst, uint32_t x, uint32_t y)
@@ -98,7 +221,61 @@ void AtlasBuilder::CopyImageToAtlas(const PixelData& src, PixelData& dst, uint32
     }
 }
 
-bool AtlasBuilder::Build(TextureAtlas& outAtlas, uint32_t maxAtlasSize, uint32_t padding)
+void AtlasBuilder::CopyImageToAtlasRotated(const PixelData& src, PixelData& dst, uint32_t x, uint32_t y)
+{
+    // Source pixel (u, v) lands at (height - 1 - v, u) in the packed block.
+    const auto* srcPixels = reinterpret_cast<const uint32_t*>(src.pixels.data());
+    auto* dstPixels = reinterpret_cast<uint32_t*>(dst.pixels.data());
+
+    for (uint32_t row = 0; row < src.width; ++row)
+    {
+        uint32_t* dstRow = dstPixels + static_cast<size_t>(y + row) * dst.width + x;
+        for (uint32_t col = 0; col < src.height; ++col)
+        {
+            dstRow[col] = srcPixels[static_cast<size_t>(src.height - 1 - col) * src.width + row];
+        }
+    }
+}
+
+bool AtlasBuilder::TryPack(TextureAtlas& outAtlas, uint32_t width, uint32_t height, uint32_t padding,
+                           bool allowRotation)
+{
+    packer_.Reset(width, height);
+    outAtlas.regions.clear();
+
+    for (const auto& image : images_)
+    {
+        const PixelData& data = image.data;
+        MaxRectsPacker::Placement placement;
+        if (!packer_.Insert(data.width + padding * 2, data.height + padding * 2, allowRotation, placement))
+            return false;
+
+        AtlasRegion region;
+        region.x = placement.x + padding;
+        region.y = placement.y + padding;
+        region.width = data.width;
+        region.height = data.height;
+        region.rotated = placement.rotated;
+        region.trimX = image.trimX;
+        region.trimY = image.trimY;
+        region.pixelSize = glm::vec2(image.sourceWidth, image.sourceHeight);
+
+        outAtlas.regions[image.id] = region;
+    }
+
+    for (const auto& alias : aliases_)
+    {
+        AtlasRegion region = outAtlas.regions[alias.sourceId];
+        region.trimX = alias.trimX;
+        region.trimY = alias.trimY;
+        region.pixelSize = glm::vec2(alias.sourceWidth, alias.sourceHeight);
+        outAtlas.regions[alias.id] = region;
+    }
+
+    return true;
+}
+
+bool AtlasBuilder::Build(TextureAtlas& outAtlas, uint32_t maxAtlasSize, uint32_t padding, bool allowRotation)
 {
     if (images_.empty())
     {
@@ -109,114 +286,104 @@ bool AtlasBuilder::Build(TextureAtlas& outAtlas, uint32_t maxAtlasSize, uint32_t
     std::ranges::sort(images_,
                       [](const ImageEntry& a, const ImageEntry& b)
                       {
-                          return a.data.height > b.data.height;
+                          const uint32_t sideA = std::max(a.data.width, a.data.height);
+                          const uint32_t sideB = std::max(b.data.width, b.data.height);
+                          if (sideA != sideB) return sideA > sideB;
+                          return a.data.width * a.data.height > b.data.width * b.data.height;
                       });
 
-    uint32_t totalArea = 0;
+    contentIndex_.clear();
+    for (size_t i = 0; i < images_.size(); ++i)
+        contentIndex_.emplace(images_[i].contentHash, i);
+
+    uint64_t totalArea = 0;
     uint32_t maxWidth = 0;
     uint32_t maxHeight = 0;
+    uint32_t maxShortSide = 0;
+    uint64_t imageArea = 0;
 
-    for (const auto& [id, data] : images_)
+    for (const auto& image : images_)
     {
-        uint32_t w = data.width + padding * 2;
-        uint32_t h = data.height + padding * 2;
-        totalArea += w * h;
+        const PixelData& data = image.data;
+        const uint32_t w = data.width + padding * 2;
+        const uint32_t h = data.height + padding * 2;
+        totalArea += static_cast<uint64_t>(w) * h;
+        imageArea += static_cast<uint64_t>(data.width) * data.height;
         maxWidth = std::max(maxWidth, w);
         maxHeight = std::max(maxHeight, h);
+        maxShortSide = std::max(maxShortSide, std::min(w, h));
     }
 
-    uint32_t atlasSize = 256;
-    while (atlasSize < maxWidth || atlasSize < maxHeight || atlasSize * atlasSize < totalArea)
+    // Candidate power-of-two sizes, square or rectangular, smallest area first.
+    std::vector<std::pair<uint32_t, uint32_t>> sizes;
+    for (uint32_t w = 64; w <= maxAtlasSize; w *= 2)
     {
-        atlasSize *= 2;
-        if (atlasSize > maxAtlasSize)
+        for (uint32_t h = 64; h <= maxAtlasSize; h *= 2)
         {
-            atlasSize = maxAtlasSize;
-            break;
+            if (static_cast<uint64_t>(w) * h < totalArea) continue;
+
+            const bool fits = allowRotation
+                                  ? std::max(w, h) >= std::max(maxWidth, maxHeight) &&
+                                  std::min(w, h) >= maxShortSide
+                                  : w >= maxWidth && h >= maxHeight;
+            if (fits) sizes.emplace_back(w, h);
         }
     }
 
-    PackNode* root = nullptr;
-    bool success = false;
-
-    while (atlasSize <= maxAtlasSize && !success)
-    {
-        delete root;
-        root = new PackNode();
-        root->x = 0;
-        root->y = 0;
-        root->width = atlasSize;
-        root->height = atlasSize;
-
-        success = true;
-        outAtlas.regions.clear();
-
-        for (const auto& [id, data] : images_)
-        {
-            const uint32_t w = data.width + padding * 2;
-            const uint32_t h = data.height + padding * 2;
-
-            if (PackNode* node = FindNode(root, w, h))
-            {
-                if (const PackNode* fit = SplitNode(node, w, h))
-                {
-                    AtlasRegion region;
-                    region.x = fit->x + padding;
-                    region.y = fit->y + padding;
-                    region.width = data.width;
-                    region.height = data.height;
-                    region.pixelSize = glm::vec2(data.width, data.height);
-
-                    outAtlas.regions[id] = region;
-                }
-                else
-                {
-                    success = false;
-                    break;
-                }
-            }
-            else
-            {
-                success = false;
-                break;
-            }
-        }
+    std::ranges::sort(sizes,
+                      [](const auto& a, const auto& b)
+                      {
+                          const uint64_t areaA = static_cast<uint64_t>(a.first) * a.second;
+                          const uint64_t areaB = static_cast<uint64_t>(b.first) * b.second;
+                          if (areaA != areaB) return areaA < areaB;
+                          return std::max(a.first, a.second) < std::max(b.first, b.second);
+                      });
 
-        if (!success)
-        {
-            atlasSize *= 2;
-        }
-    }
+    const auto packed = std::ranges::find_if(sizes,
+                                             [&](const auto& size)
+                                             {
+                                                 return TryPack(outAtlas, size.first, size.second, padding,
+                                                                allowRotation);
+                                             });
 
-    if (!success)
+    if (packed == sizes.end())
     {
-        delete root;
+        outAtlas.regions.clear();
         std::cerr << "AtlasBuilder: Failed to pack images into atlas (max size: "
             << maxAtlasSize << "x" << maxAtlasSize << ")\n";
         return false;
     }
 
-    outAtlas.atlasWidth = atlasSize;
-    outAtlas.atlasHeight = atlasSize;
-    outAtlas.atlasData.width = atlasSize;
-    outAtlas.atlasData.height = atlasSize;
-    outAtlas.atlasData.pixels.resize(atlasSize * atlasSize * 4, 0);
-
-    for (const auto& [id, data] : images_)
+    // Trim to the packed extent; backends do not need power-of-two textures.
+    const uint32_t atlasWidth = std::min(packed->first, (packer_.GetUsedWidth() + 3) & ~3u);
+    const uint32_t atlasHeight = std::min(packed->second, (packer_.GetUsedHeight() + 3) & ~3u);
+
+    outAtlas.atlasWidth = atlasWidth;
+    outAtlas.atlasHeight = atlasHeight;
+    outAtlas.dedupedImages = static_cast<uint32_t>(aliases_.size());
+    outAtlas.dedupedBytes = dedupedBytes_;
+    outAtlas.occupancy = static_cast<float>(imageArea) / static_cast<float>(
+        static_cast<uint64_t>(atlasWidth) * atlasHeight);
+    outAtlas.atlasData.width = atlasWidth;
+    outAtlas.atlasData.height = atlasHeight;
+    outAtlas.atlasData.pixels.assign(static_cast<size_t>(atlasWidth) * atlasHeight * 4, 0);
+
+    for (const auto& image : images_)
     {
-        const auto& region = outAtlas.regions[id];
-        CopyImageToAtlas(data, outAtlas.atlasData, region.x, region.y);
+        const auto& region = outAtlas.regions[image.id];
+        if (region.rotated)
+            CopyImageToAtlasRotated(image.data, outAtlas.atlasData, region.x, region.y);
+        else
+            CopyImageToAtlas(image.data, outAtlas.atlasData, region.x, region.y);
     }
 
     for (auto& region : outAtlas.regions | std::views::values)
     {
-        region.uvMin.x = static_cast<float>(region.x) / static_cast<float>(atlasSize);
-        region.uvMin.y = static_cast<float>(region.y) / static_cast<float>(atlasSize);
-        region.uvMax.x = static_cast<float>(region.x + region.width) / static_cast<float>(atlasSize);
-        region.uvMax.y = static_cast<float>(region.y + region.height) / static_cast<float>(atlasSize);
+        region.uvMin.x = static_cast<float>(region.x) / static_cast<float>(atlasWidth);
+        region.uvMin.y = static_cast<float>(region.y) / static_cast<float>(atlasHeight);
+        region.uvMax.x = static_cast<float>(region.x + region.PackedWidth()) / static_cast<float>(atlasWidth);
+        region.uvMax.y = static_cast<float>(region.y + region.PackedHeight()) / static_cast<float>(atlasHeight);
     }
 
-    delete root;
-
     return true;
 }
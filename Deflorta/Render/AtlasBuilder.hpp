@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "MaxRectsPacker.hpp"
 #include "PixelData.hpp"
 
 #include <glm/vec2.hpp>
@@ -15,6 +16,13 @@ struct AtlasRegion
     glm::vec2 pixelSize;
     uint32_t x, y;
     uint32_t width, height;
+    // Stored turned 90 degrees clockwise; width/height still describe the upright sprite.
+    bool rotated = false;
+    // Offset of the stored pixels inside the untrimmed sprite, whose size pixelSize keeps.
+    uint32_t trimX = 0, trimY = 0;
+
+    [[nodiscard]] uint32_t PackedWidth() const { return rotated ? height : width; }
+    [[nodiscard]] uint32_t PackedHeight() const { return rotated ? width : height; }
 };
 
 struct TextureAtlas
@@ -23,15 +31,21 @@ struct TextureAtlas
     std::unordered_map<std::string, AtlasRegion> regions;
     uint32_t atlasWidth = 0;
     uint32_t atlasHeight = 0;
+    float occupancy = 0.0f;
+    // Images whose pixels matched an earlier one and share its region instead of being packed.
+    uint32_t dedupedImages = 0;
+    size_t dedupedBytes = 0;
 
     bool Save(const std::string& filePath) const;
+    [[nodiscard]] PixelData ExtractRegion(const AtlasRegion& region) const;
 };
 
 class AtlasBuilder
 {
 public:
-    void AddImage(const std::string& id, const PixelData& pixelData);
-    bool Build(TextureAtlas& outAtlas, uint32_t maxAtlasSize = 4096, uint32_t padding = 1);
+    void AddImage(const std::string& id, const PixelData& pixelData, bool trimTransparent = false);
+    bool Build(TextureAtlas& outAtlas, uint32_t maxAtlasSize = 4096, uint32_t padding = 1,
+               bool allowRotation = false);
     void Clear();
 
 private:
@@ -39,26 +53,28 @@ private:
     {
         std::string id;
         PixelData data;
+        uint32_t trimX = 0, trimY = 0;
+        uint32_t sourceWidth = 0, sourceHeight = 0;
+        uint64_t contentHash = 0;
     };
 
-    std::vector<ImageEntry> images_;
-
-    struct PackNode
+    struct AliasEntry
     {
-        uint32_t x = 0, y = 0;
-        uint32_t width = 0, height = 0;
-        bool used = false;
-        PackNode* right = nullptr;
-        PackNode* down = nullptr;
-
-        ~PackNode()
-        {
-            delete right;
-            delete down;
-        }
+        std::string id;
+        std::string sourceId;
+        uint32_t trimX = 0, trimY = 0;
+        uint32_t sourceWidth = 0, sourceHeight = 0;
     };
 
-    static PackNode* FindNode(PackNode* root, uint32_t width, uint32_t height);
-    static PackNode* SplitNode(PackNode* node, uint32_t width, uint32_t height);
+    std::vector<ImageEntry> images_;
+    std::vector<AliasEntry> aliases_;
+    std::unordered_map<uint64_t, size_t> contentIndex_;
+    size_t dedupedBytes_ = 0;
+    MaxRectsPacker packer_;
+
+    bool TryPack(TextureAtlas& outAtlas, uint32_t width, uint32_t height, uint32_t padding, bool allowRotation);
+    static uint64_t HashContent(const PixelData& data);
+    static bool TrimTransparent(const PixelData& src, PixelData& outTrimmed, uint32_t& outX, uint32_t& outY);
     static void CopyImageToAtlas(const PixelData& src, PixelData& dst, uint32_t x, uint32_t y);
+    static void CopyImageToAtlasRotated(const PixelData& src, PixelData& dst, uint32_t x, uint32_t y);
 };
@@ -0,0 +1,196 @@
+#include "AtlasCache.hpp"
+
+#include "../Resource/ResourceArchive.hpp"
+#include "../Utils.hpp"
+
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    constexpr uint32_t kCacheMagic = 0x43414644; // "DFAC"
+    // Bump whenever AtlasBuilder output or this file layout changes.
+    constexpr uint32_t kCacheVersion = 4;
+    constexpr uint64_t kCheckSeed = 0x9e3779b97f4a7c15ull;
+    // Id length, x, y, width, height, rotated flag, trim offset and pixel size of one region.
+    constexpr uint64_t kMinRegionBytes = 7 * sizeof(uint32_t) + sizeof(uint8_t) + sizeof(glm::vec2);
+}
+
+AtlasCache::Key AtlasCache::ComputeKey(const std::vector<std::pair<std::string, std::string>>& sources)
+{
+    Key key;
+    key.hash = Utils::HashBytes(&kCacheVersion, sizeof(kCacheVersion));
+    key.check = Utils::HashBytes(&kCacheVersion, sizeof(kCacheVersion), kCheckSeed);
+
+    auto hash = [&key](const void* data, size_t size)
+    {
+        // Lengths go in first so moving bytes between an id and its file never gives the same key.
+        const uint64_t length = size;
+        key.hash = Utils::HashBytes(&length, sizeof(length), key.hash);
+        key.hash = Utils::HashBytes(data, size, key.hash);
+        key.check = Utils::HashBytes(&length, sizeof(length), key.check);
+        key.check = Utils::HashBytes(data, size, key.check);
+    };
+
+    for (const auto& [id, path] : sources)
+    {
+        ArchiveFile file;
+        if (!ResourceArchive::Read(path, file)) return {};
+
+        hash(id.data(), id.size());
+        hash(file.Data(), file.Size());
+    }
+
+    if (key.hash == 0) key.hash = 1;
+    return key;
+}
+
+std::filesystem::path AtlasCache::GetEntryPath(uint64_t key)
+{
+    return std::filesystem::path(Utils::GetExecutableDir()) / "cache" / "atlas" / std::format("{:016x}.atlas", key);
+}
+
+bool AtlasCache::Load(const Key& key, TextureAtlas& outAtlas)
+{
+    std::ifstream stream(GetEntryPath(key.hash), std::ios::binary | std::ios::ate);
+    if (!stream) return false;
+    const auto fileSize = static_cast<uint64_t>(stream.tellg());
+    stream.seekg(0);
+
+    auto read = [&stream](auto& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+    };
+
+    // Sizes read from a corrupt entry must not be allocated; anything larger than the rest of the file is a miss.
+    auto fits = [&stream, fileSize](uint64_t count, uint64_t elementSize)
+    {
+        return stream && count <= (fileSize - static_cast<uint64_t>(stream.tellg())) / elementSize;
+    };
+
+    uint32_t magic = 0, version = 0;
+    Key stored;
+    read(magic);
+    read(version);
+    read(stored.hash);
+    read(stored.check);
+    if (magic != kCacheMagic || version != kCacheVersion || stored.hash != key.hash || stored.check != key.check)
+        return false;
+
+    TextureAtlas atlas;
+    uint32_t regionCount = 0;
+    read(atlas.atlasWidth);
+    read(atlas.atlasHeight);
+    read(atlas.occupancy);
+    read(regionCount);
+    if (!stream || atlas.atlasWidth == 0 || atlas.atlasHeight == 0) return false;
+    if (!fits(static_cast<uint64_t>(atlas.atlasWidth) * atlas.atlasHeight, 4) || !fits(regionCount, kMinRegionBytes))
+        return false;
+
+    for (uint32_t i = 0; i < regionCount && stream; ++i)
+    {
+        uint32_t idLength = 0;
+        read(idLength);
+        if (!fits(idLength, 1)) return false;
+        std::string id(idLength, '\0');
+        stream.read(id.data(), idLength);
+
+        AtlasRegion region{};
+        uint8_t rotated = 0;
+        read(region.x);
+        read(region.y);
+        read(region.width);
+        read(region.height);
+        read(rotated);
+        read(region.trimX);
+        read(region.trimY);
+        read(region.pixelSize);
+        region.rotated = rotated != 0;
+        region.uvMin = glm::vec2(region.x, region.y) / glm::vec2(atlas.atlasWidth, atlas.atlasHeight);
+        region.uvMax = glm::vec2(region.x + region.PackedWidth(), region.y + region.PackedHeight()) /
+            glm::vec2(atlas.atlasWidth, atlas.atlasHeight);
+
+        if (region.x + region.PackedWidth() > atlas.atlasWidth ||
+            region.y + region.PackedHeight() > atlas.atlasHeight)
+            return false;
+
+        atlas.regions.emplace(std::move(id), region);
+    }
+
+    atlas.atlasData.width = atlas.atlasWidth;
+    atlas.atlasData.height = atlas.atlasHeight;
+    atlas.atlasData.pitch = atlas.atlasWidth * 4;
+    atlas.atlasData.pixels.resize(static_cast<size_t>(atlas.atlasData.pitch) * atlas.atlasHeight);
+    stream.read(reinterpret_cast<char*>(atlas.atlasData.pixels.data()),
+                static_cast<std::streamsize>(atlas.atlasData.pixels.size()));
+    if (!stream)
+    {
+        std::cerr << "AtlasCache: Ignoring truncated entry " << GetEntryPath(key.hash).string() << "\n";
+        return false;
+    }
+
+    outAtlas = std::move(atlas);
+    return true;
+}
+
+bool AtlasCache::Store(const Key& key, const TextureAtlas& atlas)
+{
+    const auto path = GetEntryPath(key.hash);
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // Written beside the entry and renamed into place so a crash never leaves a torn file behind.
+    auto tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            std::cerr << "AtlasCache: Failed to open " << tempPath.string() << " for writing\n";
+            return false;
+        }
+
+        auto write = [&stream](const auto& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+
+        write(kCacheMagic);
+        write(kCacheVersion);
+        write(key.hash);
+        write(key.check);
+        write(atlas.atlasWidth);
+        write(atlas.atlasHeight);
+        write(atlas.occupancy);
+        write(static_cast<uint32_t>(atlas.regions.size()));
+
+        for (const auto& [id, region] : atlas.regions)
+        {
+            write(static_cast<uint32_t>(id.size()));
+            stream.write(id.data(), static_cast<std::streamsize>(id.size()));
+            write(region.x);
+            write(region.y);
+            write(region.width);
+            write(region.height);
+            write(static_cast<uint8_t>(region.rotated ? 1 : 0));
+            write(region.trimX);
+            write(region.trimY);
+            write(region.pixelSize);
+        }
+
+        stream.write(reinterpret_cast<const char*>(atlas.atlasData.pixels.data()),
+                     static_cast<std::streamsize>(atlas.atlasData.pixels.size()));
+        if (!stream) return false;
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
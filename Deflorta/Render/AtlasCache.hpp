@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AtlasBuilder.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Baked reanim atlases stored under <exe>/cache/atlas. The key covers every part id, the bytes of
+// its source PNG and the cache version, so any edited or added part forces a re-bake.
+class AtlasCache final
+{
+public:
+    struct Key
+    {
+        // Names the entry file.
+        uint64_t hash = 0;
+        // Differently seeded hash of the same sources, stored in the entry so a file-name collision
+        // is caught on load.
+        uint64_t check = 0;
+
+        [[nodiscard]] bool IsValid() const { return hash != 0; }
+    };
+
+    // Sources are (part id, file path) pairs. Returns an invalid key when a source file cannot be read.
+    static Key ComputeKey(const std::vector<std::pair<std::string, std::string>>& sources);
+
+    static bool Load(const Key& key, TextureAtlas& outAtlas);
+    static bool Store(const Key& key, const TextureAtlas& atlas);
+
+private:
+    static std::filesystem::path GetEntryPath(uint64_t key);
+};
@@ -2,6 +2,8 @@
 
 #include <Windows.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 D2DRenderBackend::~D2DRenderBackend()
@@ -157,6 +159,8 @@ void D2DRenderBackend::DiscardDeviceResources()
 
     brush_.Reset();
     colorMatrixEffect_.Reset();
+    tintLookup_.clear();
+    tintVariants_.clear();
     d2dTargetBitmap_.Reset();
     swapChain_.Reset();
     d2dContext_.Reset();
@@ -210,6 +214,7 @@ void D2DRenderBackend::BeginFrame()
         if (!swapChain_) return;
     }
 
+    tintBakesThisFrame_ = 0;
     d2dContext_->BeginDraw();
 }
 
@@ -234,6 +239,17 @@ void D2DRenderBackend::Clear(const Color& color)
     d2dContext_->Clear(ConvertColor(color));
 }
 
+void D2DRenderBackend::SetDirtyRegion(const std::vector<Rect>&)
+{
+    // SupportsPartialRedraw() is false, so every frame is drawn in full and the region is ignored.
+}
+
+bool D2DRenderBackend::SupportsPartialRedraw() const
+{
+    // Flip-model back buffers do not keep the previous frame, so every frame is drawn in full.
+    return false;
+}
+
 std::shared_ptr<ITexture> D2DRenderBackend::CreateTexture(const PixelData& data)
 {
     std::lock_guard lock(mutex_);
@@ -271,6 +287,75 @@ std::shared_ptr<ITexture> D2DRenderBackend::CreateTexture(const PixelData& data)
     return std::make_shared<D2DTexture>(bitmap);
 }
 
+bool D2DRenderBackend::UpdateTexture(ITexture* texture, const PixelData& data, uint32_t x, uint32_t y)
+{
+    std::lock_guard lock(mutex_);
+
+    const auto d2dTexture = dynamic_cast<D2DTexture*>(texture);
+    if (!d2dTexture || !d2dTexture->GetBitmap() || data.pixels.empty()) return false;
+
+    const D2D1_RECT_U dest = D2D1::RectU(x, y, x + data.width, y + data.height);
+    const HRESULT hr = d2dTexture->GetBitmap()->CopyFromMemory(
+        &dest,
+        data.pixels.data(),
+        data.pitch ? data.pitch : data.width * 4);
+
+    if (FAILED(hr))
+    {
+        std::cerr << "Error: CopyFromMemory failed with HRESULT 0x" << std::hex << hr << std::dec << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+std::shared_ptr<ITexture> D2DRenderBackend::CreateRenderTarget(uint32_t width, uint32_t height)
+{
+    std::lock_guard lock(mutex_);
+
+    if (!d2dContext_ || width == 0 || height == 0) return nullptr;
+
+    const D2D1_BITMAP_PROPERTIES1 props = D2D1::BitmapProperties1(
+        D2D1_BITMAP_OPTIONS_TARGET,
+        D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+
+    Microsoft::WRL::ComPtr<ID2D1Bitmap1> bitmap;
+    const HRESULT hr = d2dContext_->CreateBitmap(
+        D2D1::SizeU(width, height),
+        nullptr,
+        0,
+        &props,
+        bitmap.GetAddressOf());
+
+    if (FAILED(hr))
+    {
+        std::cerr << "Error: CreateBitmap (render target) failed with HRESULT 0x" << std::hex << hr << std::dec << "\n";
+        return nullptr;
+    }
+
+    return std::make_shared<D2DTexture>(bitmap);
+}
+
+void D2DRenderBackend::SetRenderTarget(ITexture* target)
+{
+    std::lock_guard lock(mutex_);
+    if (!d2dContext_) return;
+
+    if (!target)
+    {
+        d2dContext_->SetTarget(d2dTargetBitmap_.Get());
+        return;
+    }
+
+    const auto d2dTexture = dynamic_cast<D2DTexture*>(target);
+    if (!d2dTexture || !d2dTexture->GetBitmap()) return;
+
+    Microsoft::WRL::ComPtr<ID2D1Bitmap1> bitmap;
+    if (FAILED(d2dTexture->GetBitmap()->QueryInterface(IID_PPV_ARGS(&bitmap)))) return;
+
+    d2dContext_->SetTarget(bitmap.Get());
+}
+
 std::shared_ptr<ITextFormat> D2DRenderBackend::CreateTextFormat(
     const std::wstring& fontFamily,
     float fontSize)
@@ -297,63 +382,26 @@ std::shared_ptr<ITextFormat> D2DRenderBackend::CreateTextFormat(
     if (FAILED(hr)) return nullptr;
 
     auto textFormat = std::make_shared<DWriteTextFormat>(format);
+    textFormat->SetDescription(fontFamily, fontSize);
     textFormatCache_[key] = textFormat;
     return textFormat;
 }
 
 void D2DRenderBackend::DrawTexture(
     ITexture* texture,
-    const glm::mat3& transform,
+    const Affine2D& transform,
     float opacity,
     const Color& tint)
 {
-    std::lock_guard lock(mutex_);
-
     if (!texture) return;
 
-    const auto d2dTexture = dynamic_cast<D2DTexture*>(texture);
-    ID2D1Bitmap* bitmap = d2dTexture->GetBitmap();
-    if (!bitmap) return;
-
-    const auto size = bitmap->GetSize();
-    const bool hasTint = tint.value.r != 1.0f || tint.value.g != 1.0f ||
-        tint.value.b != 1.0f || tint.value.a != 1.0f;
-
-    d2dContext_->SetTransform(ConvertMatrix(transform));
-
-    if (hasTint)
-    {
-        if (!colorMatrixEffect_)
-        {
-            d2dContext_->CreateEffect(CLSID_D2D1ColorMatrix, &colorMatrixEffect_);
-        }
-
-        colorMatrixEffect_->SetInput(0, bitmap);
-
-        const D2D1_MATRIX_5X4_F matrix = D2D1::Matrix5x4F(
-            tint.value.r, 0, 0, 0,
-            0, tint.value.g, 0, 0,
-            0, 0, tint.value.b, 0,
-            0, 0, 0, tint.value.a,
-            0, 0, 0, 0
-        );
-        colorMatrixEffect_->SetValue(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, matrix);
-        d2dContext_->DrawImage(colorMatrixEffect_.Get());
-    }
-    else
-    {
-        d2dContext_->DrawBitmap(
-            bitmap,
-            D2D1::RectF(0, 0, size.width, size.height),
-            opacity);
-    }
-
-    d2dContext_->SetTransform(D2D1::Matrix3x2F::Identity());
+    const glm::vec2 size = texture->GetSize();
+    DrawTextureRect(texture, transform, Rect(0.0f, 0.0f, size.x, size.y), opacity, tint);
 }
 
 void D2DRenderBackend::DrawTextureRect(
     ITexture* texture,
-    const glm::mat3& transform,
+    const Affine2D& transform,
     const Rect& sourceRect,
     float opacity,
     const Color& tint)
@@ -368,50 +416,151 @@ void D2DRenderBackend::DrawTextureRect(
 
     const float destWidth = sourceRect.Width();
     const float destHeight = sourceRect.Height();
-    const bool hasTint = tint.value.r != 1.0f || tint.value.g != 1.0f ||
-        tint.value.b != 1.0f || tint.value.a != 1.0f;
+    const D2D1_RECT_F destRect = D2D1::RectF(0, 0, destWidth, destHeight);
+    const D2D1_RECT_F srcRect = ConvertRect(sourceRect);
+
+    // Tint alpha only scales opacity; just the RGB part needs a tinted copy of the pixels.
+    const bool hasTint = tint.value.r != 1.0f || tint.value.g != 1.0f || tint.value.b != 1.0f;
+    const float alpha = opacity * tint.value.a;
 
     d2dContext_->SetTransform(ConvertMatrix(transform));
 
-    if (hasTint)
+    if (!hasTint)
     {
-        if (!colorMatrixEffect_)
-        {
-            d2dContext_->CreateEffect(CLSID_D2D1ColorMatrix, &colorMatrixEffect_);
-        }
-
-        colorMatrixEffect_->SetInput(0, bitmap);
-
-        const D2D1_MATRIX_5X4_F matrix = D2D1::Matrix5x4F(
-            tint.value.r, 0, 0, 0,
-            0, tint.value.g, 0, 0,
-            0, 0, tint.value.b, 0,
-            0, 0, 0, tint.value.a,
-            0, 0, 0, 0
-        );
-        colorMatrixEffect_->SetValue(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, matrix);
-
-        d2dContext_->DrawImage(colorMatrixEffect_.Get(),
-                               D2D1::Point2F(0, 0),
-                               D2D1::RectF(sourceRect.Left(), sourceRect.Top(), sourceRect.Right(),
-                                           sourceRect.Bottom()),
-                               D2D1_INTERPOLATION_MODE_LINEAR);
+        d2dContext_->DrawBitmap(bitmap, destRect, alpha, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, srcRect);
+    }
+    else if (ID2D1Bitmap* tinted = GetTintedBitmap(bitmap, srcRect, QuantizeTint(tint)))
+    {
+        d2dContext_->DrawBitmap(tinted, destRect, alpha, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR, destRect);
     }
     else
     {
-        d2dContext_->DrawBitmap(
-            bitmap,
-            D2D1::RectF(0, 0, destWidth, destHeight),
-            opacity,
-            D2D1_BITMAP_INTERPOLATION_MODE_LINEAR,
-            D2D1::RectF(sourceRect.Left(), sourceRect.Top(), sourceRect.Right(), sourceRect.Bottom()));
+        DrawTintEffect(bitmap, srcRect, opacity, tint);
+    }
+
+    d2dContext_->SetTransform(D2D1::Matrix3x2F::Identity());
+}
+
+ID2D1Bitmap* D2DRenderBackend::GetTintedBitmap(ID2D1Bitmap* source, const D2D1_RECT_F& sourceRect, uint32_t tint)
+{
+    const TintKey key{source, sourceRect.left, sourceRect.top, sourceRect.right, sourceRect.bottom, tint};
+
+    const auto it = tintLookup_.find(key);
+    if (it != tintLookup_.end())
+    {
+        tintVariants_.splice(tintVariants_.begin(), tintVariants_, it->second);
+        return it->second->bitmap.Get();
     }
 
+    if (tintBakesThisFrame_ >= kMaxTintBakesPerFrame) return nullptr;
+    ++tintBakesThisFrame_;
+
+    if (!colorMatrixEffect_ && FAILED(d2dContext_->CreateEffect(CLSID_D2D1ColorMatrix, &colorMatrixEffect_)))
+        return nullptr;
+
+    const auto width = static_cast<uint32_t>(std::ceil(sourceRect.right - sourceRect.left));
+    const auto height = static_cast<uint32_t>(std::ceil(sourceRect.bottom - sourceRect.top));
+    if (width == 0 || height == 0) return nullptr;
+
+    const D2D1_BITMAP_PROPERTIES1 props = D2D1::BitmapProperties1(
+        D2D1_BITMAP_OPTIONS_TARGET,
+        D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+
+    TintVariant variant;
+    variant.key = key;
+    variant.source = source;
+    if (FAILED(d2dContext_->CreateBitmap(D2D1::SizeU(width, height), nullptr, 0, &props,
+        variant.bitmap.GetAddressOf())))
+        return nullptr;
+
+    Microsoft::WRL::ComPtr<ID2D1Image> previousTarget;
+    D2D1_MATRIX_3X2_F previousTransform;
+    d2dContext_->GetTarget(previousTarget.GetAddressOf());
+    d2dContext_->GetTransform(&previousTransform);
+
+    d2dContext_->SetTarget(variant.bitmap.Get());
     d2dContext_->SetTransform(D2D1::Matrix3x2F::Identity());
+    d2dContext_->Clear(D2D1::ColorF(0, 0, 0, 0));
+
+    colorMatrixEffect_->SetInput(0, source);
+    SetTintMatrix(DequantizeTint(tint), 1.0f);
+    d2dContext_->DrawImage(colorMatrixEffect_.Get(), D2D1::Point2F(0, 0), sourceRect,
+                           D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR);
+
+    d2dContext_->SetTarget(previousTarget.Get());
+    d2dContext_->SetTransform(previousTransform);
+
+    if (tintVariants_.size() >= kMaxTintVariants)
+    {
+        tintLookup_.erase(tintVariants_.back().key);
+        tintVariants_.pop_back();
+    }
+
+    tintVariants_.push_front(std::move(variant));
+    tintLookup_[key] = tintVariants_.begin();
+    return tintVariants_.front().bitmap.Get();
+}
+
+void D2DRenderBackend::DrawTintEffect(ID2D1Bitmap* bitmap, const D2D1_RECT_F& sourceRect, float opacity,
+                                      const Color& tint)
+{
+    if (!colorMatrixEffect_ && FAILED(d2dContext_->CreateEffect(CLSID_D2D1ColorMatrix, &colorMatrixEffect_)))
+        return;
+
+    colorMatrixEffect_->SetInput(0, bitmap);
+    SetTintMatrix(tint, tint.value.a * opacity);
+    d2dContext_->DrawImage(colorMatrixEffect_.Get(), D2D1::Point2F(0, 0), sourceRect,
+                           D2D1_INTERPOLATION_MODE_LINEAR);
+}
+
+void D2DRenderBackend::SetTintMatrix(const Color& tint, float alpha)
+{
+    const D2D1_MATRIX_5X4_F matrix = D2D1::Matrix5x4F(
+        tint.value.r, 0, 0, 0,
+        0, tint.value.g, 0, 0,
+        0, 0, tint.value.b, 0,
+        0, 0, 0, alpha,
+        0, 0, 0, 0
+    );
+    colorMatrixEffect_->SetValue(D2D1_COLORMATRIX_PROP_COLOR_MATRIX, matrix);
+}
+
+uint32_t D2DRenderBackend::QuantizeTint(const Color& tint)
+{
+    // 6 bits per channel in steps of 1/32, so brightening tints up to 2x still get their own variant.
+    const auto quantize = [](float channel)
+    {
+        return static_cast<uint32_t>(std::lround(std::clamp(channel, 0.0f, 63.0f / 32.0f) * 32.0f));
+    };
+    return quantize(tint.value.r) | (quantize(tint.value.g) << 6) | (quantize(tint.value.b) << 12);
+}
+
+Color D2DRenderBackend::DequantizeTint(uint32_t tint)
+{
+    return {
+        static_cast<float>(tint & 0x3F) / 32.0f,
+        static_cast<float>((tint >> 6) & 0x3F) / 32.0f,
+        static_cast<float>((tint >> 12) & 0x3F) / 32.0f
+    };
+}
+
+size_t D2DRenderBackend::TintKeyHash::operator()(const TintKey& key) const
+{
+    size_t hash = std::hash<const void*>{}(key.bitmap);
+    const auto combine = [&hash](size_t value)
+    {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<float>{}(key.left));
+    combine(std::hash<float>{}(key.top));
+    combine(std::hash<float>{}(key.right));
+    combine(std::hash<float>{}(key.bottom));
+    combine(key.tint);
+    return hash;
 }
 
 void D2DRenderBackend::DrawTexts(
-    const std::wstring& text,
+    std::wstring_view text,
     const Rect& layoutRect,
     ITextFormat* textFormat,
     const Color& color,
@@ -466,7 +615,7 @@ void D2DRenderBackend::DrawTexts(
     brush_->SetColor(ConvertColor(color));
 
     d2dContext_->DrawTextW(
-        text.c_str(),
+        text.data(),
         static_cast<UINT32>(text.size()),
         dwFormat->GetFormat(),
         ConvertRect(layoutRect),
@@ -503,13 +652,13 @@ void D2DRenderBackend::DrawRectangle(
     }
 }
 
-void D2DRenderBackend::SetTransform(const glm::mat3& transform)
+void D2DRenderBackend::SetTransform(const Affine2D& transform)
 {
     std::lock_guard lock(mutex_);
     d2dContext_->SetTransform(ConvertMatrix(transform));
 }
 
-glm::mat3 D2DRenderBackend::GetTransform() const
+Affine2D D2DRenderBackend::GetTransform() const
 {
     D2D1_MATRIX_3X2_F mat;
     d2dContext_->GetTransform(&mat);
@@ -530,12 +679,12 @@ void D2DRenderBackend::Unlock()
     mutex_.unlock();
 }
 
-D2D1_MATRIX_3X2_F D2DRenderBackend::ConvertMatrix(const glm::mat3& mat)
+D2D1_MATRIX_3X2_F D2DRenderBackend::ConvertMatrix(const Affine2D& mat)
 {
     return D2D1::Matrix3x2F(
-        mat[0][0], mat[0][1],
-        mat[1][0], mat[1][1],
-        mat[2][0], mat[2][1]);
+        mat.m11, mat.m12,
+        mat.m21, mat.m22,
+        mat.dx, mat.dy);
 }
 
 D2D1_COLOR_F D2DRenderBackend::ConvertColor(const Color& color)
@@ -8,6 +8,7 @@
 #include <dxgi1_2.h>
 #include <wrl/client.h>
 
+#include <list>
 #include <unordered_map>
 #include <mutex>
 
@@ -72,27 +73,32 @@ public:
     void BeginFrame() override;
     void EndFrame() override;
     void Clear(const Color& color) override;
+    void SetDirtyRegion(const std::vector<Rect>& rects) override;
+    bool SupportsPartialRedraw() const override;
 
     std::shared_ptr<ITexture> CreateTexture(const PixelData& data) override;
+    std::shared_ptr<ITexture> CreateRenderTarget(uint32_t width, uint32_t height) override;
+    bool UpdateTexture(ITexture* texture, const PixelData& data, uint32_t x, uint32_t y) override;
+    void SetRenderTarget(ITexture* target) override;
     std::shared_ptr<ITextFormat> CreateTextFormat(
         const std::wstring& fontFamily,
         float fontSize) override;
 
     void DrawTexture(
         ITexture* texture,
-        const glm::mat3& transform,
+        const Affine2D& transform,
         float opacity,
         const Color& tint) override;
 
     void DrawTextureRect(
         ITexture* texture,
-        const glm::mat3& transform,
+        const Affine2D& transform,
         const Rect& sourceRect,
         float opacity,
         const Color& tint) override;
 
     void DrawTexts(
-        const std::wstring& text,
+        std::wstring_view text,
         const Rect& layoutRect,
         ITextFormat* textFormat,
         const Color& color,
@@ -104,16 +110,46 @@ public:
         float strokeWidth,
         bool filled = false) override;
 
-    void SetTransform(const glm::mat3& transform) override;
-    glm::mat3 GetTransform() const override;
+    void SetTransform(const Affine2D& transform) override;
+    Affine2D GetTransform() const override;
 
     void Lock() override;
     void Unlock() override;
 
 private:
+    static constexpr size_t kMaxTintVariants = 512;
+    static constexpr uint32_t kMaxTintBakesPerFrame = 32;
+
+    struct TintKey
+    {
+        ID2D1Bitmap* bitmap = nullptr;
+        float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+        uint32_t tint = 0;
+
+        bool operator==(const TintKey&) const = default;
+    };
+
+    struct TintKeyHash
+    {
+        size_t operator()(const TintKey& key) const;
+    };
+
+    struct TintVariant
+    {
+        TintKey key;
+        Microsoft::WRL::ComPtr<ID2D1Bitmap> source;
+        Microsoft::WRL::ComPtr<ID2D1Bitmap1> bitmap;
+    };
+
     void RecreateTargetBitmap();
+    ID2D1Bitmap* GetTintedBitmap(ID2D1Bitmap* source, const D2D1_RECT_F& sourceRect, uint32_t tint);
+    void DrawTintEffect(ID2D1Bitmap* bitmap, const D2D1_RECT_F& sourceRect, float opacity, const Color& tint);
+    void SetTintMatrix(const Color& tint, float alpha);
 
-    static D2D1_MATRIX_3X2_F ConvertMatrix(const glm::mat3& mat);
+    static uint32_t QuantizeTint(const Color& tint);
+    static Color DequantizeTint(uint32_t tint);
+
+    static D2D1_MATRIX_3X2_F ConvertMatrix(const Affine2D& mat);
     static D2D1_COLOR_F ConvertColor(const Color& color);
     static D2D1_RECT_F ConvertRect(const Rect& rect);
 
@@ -133,4 +169,8 @@ private:
 
     std::unordered_map<std::wstring, std::shared_ptr<ITextFormat>> textFormatCache_;
     Microsoft::WRL::ComPtr<ID2D1Effect> colorMatrixEffect_;
+
+    std::list<TintVariant> tintVariants_;
+    std::unordered_map<TintKey, std::list<TintVariant>::iterator, TintKeyHash> tintLookup_;
+    uint32_t tintBakesThisFrame_ = 0;
 };
@@ -0,0 +1,529 @@
+#include "DrawCapture.hpp"
+#include "GlobalAtlas.hpp"
+
+#include "../Resource/ReanimationLoader.hpp"
+#include "../Resource/ResourceManager.hpp"
+
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace
+{
+    constexpr uint32_t kCaptureMagic = 0x50434644; // "DFCP"
+    constexpr uint32_t kCaptureVersion = 4;
+
+    class CaptureWriter
+    {
+    public:
+        explicit CaptureWriter(std::ofstream& stream) : stream_(stream)
+        {
+        }
+
+        template <typename T>
+        void Write(const T& value)
+        {
+            stream_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void WriteString(const std::string& value)
+        {
+            Write(static_cast<uint32_t>(value.size()));
+            stream_.write(value.data(), static_cast<std::streamsize>(value.size()));
+        }
+
+        void WriteWString(std::wstring_view value)
+        {
+            Write(static_cast<uint32_t>(value.size()));
+            for (const wchar_t c : value)
+                Write(static_cast<uint16_t>(c));
+        }
+
+        void WriteRect(const Rect& rect)
+        {
+            Write(rect.min);
+            Write(rect.max);
+        }
+
+    private:
+        std::ofstream& stream_;
+    };
+
+    class CaptureReader
+    {
+    public:
+        explicit CaptureReader(std::ifstream& stream) : stream_(stream)
+        {
+            stream_.seekg(0, std::ios::end);
+            size_ = static_cast<uint64_t>(stream_.tellg());
+            stream_.seekg(0, std::ios::beg);
+        }
+
+        template <typename T>
+        T Read()
+        {
+            T value{};
+            stream_.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const auto length = Read<uint32_t>();
+            if (!Fits(length, sizeof(char))) return {};
+
+            std::string value(length, '\0');
+            stream_.read(value.data(), static_cast<std::streamsize>(value.size()));
+            return value;
+        }
+
+        std::wstring ReadWString()
+        {
+            const auto length = Read<uint32_t>();
+            if (!Fits(length, sizeof(uint16_t))) return {};
+
+            std::wstring value(length, L'\0');
+            for (auto& c : value)
+                c = static_cast<wchar_t>(Read<uint16_t>());
+            return value;
+        }
+
+        // Counts come from the file, so one that runs past its end marks the capture as corrupt instead of
+        // being allocated.
+        bool Fits(uint64_t count, size_t elementSize)
+        {
+            if (stream_.good() && count <= (size_ - static_cast<uint64_t>(stream_.tellg())) / elementSize)
+                return true;
+            stream_.setstate(std::ios::failbit);
+            return false;
+        }
+
+        Rect ReadRect()
+        {
+            const auto minPoint = Read<glm::vec2>();
+            const auto maxPoint = Read<glm::vec2>();
+            return {minPoint, maxPoint};
+        }
+
+        [[nodiscard]] bool Good() const { return stream_.good(); }
+
+    private:
+        std::ifstream& stream_;
+        uint64_t size_ = 0;
+    };
+
+    // Type, z, opacity, sequence and bounds precede every item's payload.
+    constexpr size_t kMinItemBytes = sizeof(uint8_t) + sizeof(int32_t) + sizeof(float) + sizeof(uint64_t) +
+        2 * sizeof(glm::vec2);
+
+    struct SaveTables
+    {
+        std::vector<std::string> textures;
+        std::unordered_map<const ITexture*, int32_t> textureIndices;
+        std::vector<std::string> atlasIds;
+        std::unordered_map<std::string, int32_t> atlasIdIndices;
+        std::map<std::tuple<const ITexture*, uint32_t, uint32_t, uint32_t, uint32_t>, int32_t> atlasRegionIndices;
+        std::vector<const ITextFormat*> fonts;
+        std::unordered_map<const ITextFormat*, int32_t> fontIndices;
+        std::unordered_map<const RenderLayerCache*, uint32_t> cacheIndices;
+
+        int32_t TextureIndex(const ITexture* texture)
+        {
+            if (!texture || texture->GetName().empty()) return -1;
+            const auto [it, inserted] = textureIndices.try_emplace(texture, static_cast<int32_t>(textures.size()));
+            if (inserted) textures.push_back(texture->GetName());
+            return it->second;
+        }
+
+        // Global atlas pages are packed in load order, so items on them are saved by entry id and placed
+        // again on replay instead of by page name and position.
+        int32_t AtlasIndex(const DrawItem::ImageAtlasData& data)
+        {
+            if (!data.texture || !data.texture->GetName().starts_with("atlas:")) return -1;
+
+            const auto& region = data.region;
+            const auto key = std::make_tuple(data.texture.get(), region.x, region.y, region.trimX, region.trimY);
+            if (const auto found = atlasRegionIndices.find(key); found != atlasRegionIndices.end())
+                return found->second;
+
+            int32_t index = -1;
+            if (auto id = GlobalAtlas::FindId(data.texture.get(), region); !id.empty())
+            {
+                const auto [it, inserted] = atlasIdIndices.try_emplace(id, static_cast<int32_t>(atlasIds.size()));
+                if (inserted) atlasIds.push_back(std::move(id));
+                index = it->second;
+            }
+            atlasRegionIndices.emplace(key, index);
+            return index;
+        }
+
+        int32_t FontIndex(const ITextFormat* format)
+        {
+            if (!format) return -1;
+            const auto [it, inserted] = fontIndices.try_emplace(format, static_cast<int32_t>(fonts.size()));
+            if (inserted) fonts.push_back(format);
+            return it->second;
+        }
+
+        uint32_t CacheIndex(const RenderLayerCache* cache)
+        {
+            return cacheIndices.try_emplace(cache, static_cast<uint32_t>(cacheIndices.size())).first->second;
+        }
+    };
+
+    struct LoadTables
+    {
+        std::vector<std::shared_ptr<ITexture>> textures;
+        std::vector<std::shared_ptr<const AtlasEntry>> atlasEntries;
+        std::vector<std::shared_ptr<ITextFormat>> fonts;
+        std::vector<std::shared_ptr<RenderLayerCache>> caches;
+
+        std::shared_ptr<RenderLayerCache> Cache(uint32_t index)
+        {
+            if (index >= caches.size()) caches.resize(index + 1);
+            if (!caches[index]) caches[index] = std::make_shared<RenderLayerCache>();
+            return caches[index];
+        }
+    };
+
+    // Captured frames outlive the frame arena their text points into, so every text payload gets its own copy.
+    std::vector<DrawItem> CopyOwned(const std::vector<DrawItem>& items)
+    {
+        std::vector<DrawItem> copy(items);
+        for (auto& item : copy)
+        {
+            if (item.drawType == DrawType::Text)
+                item.data.text.MakeOwned();
+            else if (item.drawType == DrawType::CachedLayer && item.data.cachedLayer.items)
+                item.data.cachedLayer.items = std::make_shared<const std::vector<DrawItem>>(
+                    CopyOwned(*item.data.cachedLayer.items));
+        }
+        return copy;
+    }
+
+    void IndexItems(const std::vector<DrawItem>& items, SaveTables& tables)
+    {
+        for (const auto& item : items)
+        {
+            if (item.drawType == DrawType::Image)
+                tables.TextureIndex(item.data.image.texture.get());
+            else if (item.drawType == DrawType::ImageAtlas && tables.AtlasIndex(item.data.imageAtlas) < 0)
+                tables.TextureIndex(item.data.imageAtlas.texture.get());
+            else if (item.drawType == DrawType::Text)
+                tables.FontIndex(item.data.text.textFormat.get());
+            else if (item.drawType == DrawType::CachedLayer && item.data.cachedLayer.items)
+                IndexItems(*item.data.cachedLayer.items, tables);
+        }
+    }
+
+    void WriteItems(CaptureWriter& writer, const std::vector<DrawItem>& items, SaveTables& tables)
+    {
+        writer.Write(static_cast<uint32_t>(items.size()));
+        for (const auto& item : items)
+        {
+            writer.Write(static_cast<uint8_t>(item.drawType));
+            writer.Write(static_cast<int32_t>(item.z));
+            writer.Write(item.opacity);
+            writer.Write(item.seq);
+            writer.WriteRect(item.bounds);
+
+            switch (item.drawType)
+            {
+            case DrawType::Image:
+                writer.Write(tables.TextureIndex(item.data.image.texture.get()));
+                writer.Write(item.data.image.transform);
+                writer.Write(item.data.image.tint.value);
+                break;
+            case DrawType::ImageAtlas:
+                {
+                    const int32_t atlasIndex = tables.AtlasIndex(item.data.imageAtlas);
+                    writer.Write(atlasIndex < 0 ? tables.TextureIndex(item.data.imageAtlas.texture.get()) : -1);
+                    writer.Write(atlasIndex);
+                }
+                writer.Write(item.data.imageAtlas.transform);
+                writer.Write(item.data.imageAtlas.region);
+                writer.Write(item.data.imageAtlas.tint.value);
+                break;
+            case DrawType::Text:
+                writer.Write(tables.FontIndex(item.data.text.textFormat.get()));
+                writer.WriteWString(item.data.text.text);
+                writer.WriteRect(item.data.text.rect);
+                writer.Write(item.data.text.color.value);
+                writer.Write(static_cast<uint8_t>(item.data.text.justification));
+                break;
+            case DrawType::Rectangle:
+                writer.WriteRect(item.data.rectangle.rect);
+                writer.Write(item.data.rectangle.color.value);
+                writer.Write(item.data.rectangle.strokeWidth);
+                writer.Write(static_cast<uint8_t>(item.data.rectangle.filled));
+                break;
+            case DrawType::CachedLayer:
+                {
+                    const auto& layer = item.data.cachedLayer;
+                    writer.Write(tables.CacheIndex(layer.cache.get()));
+                    writer.WriteRect(layer.bounds);
+                    writer.Write(layer.version);
+                    WriteItems(writer, layer.items ? *layer.items : std::vector<DrawItem>{}, tables);
+                }
+                break;
+            }
+        }
+    }
+
+    bool ReadItems(CaptureReader& reader, std::vector<DrawItem>& items, LoadTables& tables)
+    {
+        const auto count = reader.Read<uint32_t>();
+        if (!reader.Fits(count, kMinItemBytes)) return false;
+        items.reserve(count);
+
+        auto texture = [&tables](int32_t index)
+        {
+            return index >= 0 && index < static_cast<int32_t>(tables.textures.size())
+                       ? tables.textures[index]
+                       : nullptr;
+        };
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            DrawItem item;
+            item.drawType = static_cast<DrawType>(reader.Read<uint8_t>());
+            item.z = reader.Read<int32_t>();
+            item.opacity = reader.Read<float>();
+            item.seq = reader.Read<uint64_t>();
+            item.bounds = reader.ReadRect();
+
+            switch (item.drawType)
+            {
+            case DrawType::Image:
+                {
+                    auto tex = texture(reader.Read<int32_t>());
+                    const auto transform = reader.Read<Affine2D>();
+                    new(&item.data.image) DrawItem::ImageData(std::move(tex), transform);
+                    item.data.image.tint = Color(reader.Read<glm::vec4>());
+                }
+                break;
+            case DrawType::ImageAtlas:
+                {
+                    auto tex = texture(reader.Read<int32_t>());
+                    const auto atlasIndex = reader.Read<int32_t>();
+                    auto transform = reader.Read<Affine2D>();
+                    auto region = reader.Read<AtlasRegion>();
+                    if (atlasIndex >= 0 && atlasIndex < static_cast<int32_t>(tables.atlasEntries.size()) &&
+                        tables.atlasEntries[atlasIndex])
+                    {
+                        // The replay may have packed the entry elsewhere or loaded it untrimmed, so swap in its
+                        // region and move the baked trim offset to match.
+                        const auto& entry = *tables.atlasEntries[atlasIndex];
+                        const glm::vec2 trimDelta(static_cast<float>(entry.region.trimX) - region.trimX,
+                                                  static_cast<float>(entry.region.trimY) - region.trimY);
+                        if (trimDelta != glm::vec2(0.0f))
+                            transform = transform * MatrixHelper::Translation(trimDelta);
+                        tex = entry.page;
+                        region = entry.region;
+                    }
+                    new(&item.data.imageAtlas) DrawItem::ImageAtlasData(std::move(tex), transform, region);
+                    item.data.imageAtlas.tint = Color(reader.Read<glm::vec4>());
+                }
+                break;
+            case DrawType::Text:
+                {
+                    const auto fontIndex = reader.Read<int32_t>();
+                    auto text = reader.ReadWString();
+                    const Rect rect = reader.ReadRect();
+                    const Color color(reader.Read<glm::vec4>());
+                    const auto justification = static_cast<Justification>(reader.Read<uint8_t>());
+                    auto format = fontIndex >= 0 && fontIndex < static_cast<int32_t>(tables.fonts.size())
+                                      ? tables.fonts[fontIndex]
+                                      : nullptr;
+                    new(&item.data.text) DrawItem::TextData(text, std::move(format), rect, color, justification);
+                    item.data.text.MakeOwned();
+                }
+                break;
+            case DrawType::Rectangle:
+                {
+                    const Rect rect = reader.ReadRect();
+                    const Color color(reader.Read<glm::vec4>());
+                    const auto strokeWidth = reader.Read<float>();
+                    const bool filled = reader.Read<uint8_t>() != 0;
+                    new(&item.data.rectangle) DrawItem::RectangleData(rect, color, strokeWidth, filled);
+                }
+                break;
+            case DrawType::CachedLayer:
+                {
+                    // Save numbers caches in the order they first appear, so a new index is always the next one.
+                    const auto cacheIndex = reader.Read<uint32_t>();
+                    if (cacheIndex > tables.caches.size()) return false;
+                    auto cache = tables.Cache(cacheIndex);
+                    const Rect bounds = reader.ReadRect();
+                    const auto version = reader.Read<uint64_t>();
+                    auto children = std::make_shared<std::vector<DrawItem>>();
+                    if (!ReadItems(reader, *children, tables)) return false;
+                    new(&item.data.cachedLayer) DrawItem::CachedLayerData(std::move(cache), std::move(children),
+                                                                          bounds, version);
+                }
+                break;
+            default:
+                return false;
+            }
+
+            if (!reader.Good()) return false;
+            items.push_back(std::move(item));
+        }
+        return true;
+    }
+}
+
+void DrawCapture::AddFrame(const std::vector<DrawItem>& items)
+{
+    frames_.push_back(CopyOwned(items));
+}
+
+void DrawCapture::Clear()
+{
+    frames_.clear();
+}
+
+bool DrawCapture::Save(const std::string& filePath) const
+{
+    std::ofstream stream(filePath, std::ios::binary);
+    if (!stream)
+    {
+        std::cerr << "Error: Failed to open capture file for writing: " << filePath << "\n";
+        return false;
+    }
+
+    SaveTables tables;
+    for (const auto& frame : frames_)
+        IndexItems(frame, tables);
+
+    CaptureWriter writer(stream);
+    writer.Write(kCaptureMagic);
+    writer.Write(kCaptureVersion);
+
+    writer.Write(static_cast<uint32_t>(tables.textures.size()));
+    for (const auto& name : tables.textures)
+        writer.WriteString(name);
+
+    writer.Write(static_cast<uint32_t>(tables.atlasIds.size()));
+    for (const auto& id : tables.atlasIds)
+        writer.WriteString(id);
+
+    writer.Write(static_cast<uint32_t>(tables.fonts.size()));
+    for (const auto* format : tables.fonts)
+    {
+        writer.WriteWString(format->GetFontFamily());
+        writer.Write(format->GetFontSize());
+    }
+
+    writer.Write(static_cast<uint32_t>(frames_.size()));
+    for (const auto& frame : frames_)
+        WriteItems(writer, frame, tables);
+
+    return stream.good();
+}
+
+bool DrawCapture::Load(const std::string& filePath, IRenderBackend* backend, const TextureResolver& resolver,
+                       const AtlasResolver& atlasResolver)
+{
+    std::ifstream stream(filePath, std::ios::binary);
+    if (!stream)
+    {
+        std::cerr << "Error: Failed to open capture file: " << filePath << "\n";
+        return false;
+    }
+
+    CaptureReader reader(stream);
+    if (reader.Read<uint32_t>() != kCaptureMagic || reader.Read<uint32_t>() != kCaptureVersion)
+    {
+        std::cerr << "Error: Unsupported capture file: " << filePath << "\n";
+        return false;
+    }
+
+    LoadTables tables;
+
+    const auto textureCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < textureCount && reader.Good(); ++i)
+    {
+        const std::string name = reader.ReadString();
+        auto texture = resolver ? resolver(name) : nullptr;
+        if (!texture)
+            std::cerr << "Warning: Capture texture '" << name << "' could not be resolved\n";
+        tables.textures.push_back(std::move(texture));
+    }
+
+    const auto atlasCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < atlasCount && reader.Good(); ++i)
+    {
+        const std::string id = reader.ReadString();
+        auto entry = atlasResolver ? atlasResolver(id) : nullptr;
+        if (!entry)
+            std::cerr << "Warning: Capture atlas entry '" << id << "' could not be resolved\n";
+        tables.atlasEntries.push_back(std::move(entry));
+    }
+
+    const auto fontCount = reader.Read<uint32_t>();
+    for (uint32_t i = 0; i < fontCount && reader.Good(); ++i)
+    {
+        const std::wstring family = reader.ReadWString();
+        const auto size = reader.Read<float>();
+        tables.fonts.push_back(backend ? backend->CreateTextFormat(family, size) : nullptr);
+    }
+
+    frames_.clear();
+    const auto frameCount = reader.Read<uint32_t>();
+    if (!reader.Good())
+    {
+        std::cerr << "Error: Capture file is truncated or corrupt: " << filePath << "\n";
+        return false;
+    }
+
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+        std::vector<DrawItem> items;
+        if (!ReadItems(reader, items, tables))
+        {
+            std::cerr << "Error: Capture file is truncated or corrupt: " << filePath << "\n";
+            return false;
+        }
+        frames_.push_back(std::move(items));
+    }
+
+    return true;
+}
+
+std::shared_ptr<ITexture> DrawCapture::ResolveResourceTexture(const std::string& name)
+{
+    if (name.starts_with("reanim:"))
+    {
+        const auto def = ReanimationLoader::LoadFromFile(name.substr(7));
+        return def.has_value() ? def.value()->atlasTexture : nullptr;
+    }
+
+    // Saves that found no entry id keep page names, which only match when the replay loads the same assets.
+    if (name.starts_with("atlas:"))
+    {
+        size_t index = 0;
+        std::from_chars(name.data() + 6, name.data() + name.size(), index);
+        return GlobalAtlas::GetPage(index);
+    }
+
+    if (name.starts_with("IMAGE_REANIM_"))
+        ResourceManager::PreloadReanimImage(name);
+    return ResourceManager::GetImage(name);
+}
+
+std::shared_ptr<const AtlasEntry> DrawCapture::ResolveAtlasEntry(const std::string& id)
+{
+    if (auto entry = GlobalAtlas::Find(id))
+        return entry;
+
+    // Reanim parts share their ids with the standalone reanim images, which land in the same atlas.
+    if (id.starts_with("IMAGE_REANIM_"))
+        ResourceManager::PreloadReanimImage(id);
+    else
+        ResourceManager::GetImage(id);
+    return GlobalAtlas::Find(id);
+}
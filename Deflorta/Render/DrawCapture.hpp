@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Renderer.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class DrawCapture final
+{
+public:
+    using TextureResolver = std::function<std::shared_ptr<ITexture>(const std::string& name)>;
+    using AtlasResolver = std::function<std::shared_ptr<const AtlasEntry>(const std::string& id)>;
+
+    void AddFrame(const std::vector<DrawItem>& items);
+    void Clear();
+
+    [[nodiscard]] size_t GetFrameCount() const { return frames_.size(); }
+    [[nodiscard]] std::vector<std::vector<DrawItem>>& GetFrames() { return frames_; }
+
+    bool Save(const std::string& filePath) const;
+    bool Load(const std::string& filePath, IRenderBackend* backend, const TextureResolver& resolver,
+              const AtlasResolver& atlasResolver);
+
+    static std::shared_ptr<ITexture> ResolveResourceTexture(const std::string& name);
+    // Loads the image or reanim part behind a global atlas id and returns its entry.
+    static std::shared_ptr<const AtlasEntry> ResolveAtlasEntry(const std::string& id);
+
+private:
+    std::vector<std::vector<DrawItem>> frames_;
+};
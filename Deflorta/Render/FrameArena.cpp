@@ -0,0 +1,99 @@
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+FrameArena::FrameArena(size_t chunkSize)
+    : chunkSize_(std::max<size_t>(chunkSize, 1024))
+{
+    AddChunk(nullptr, chunkSize_);
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+    const size_t padded = size + alignment - 1;
+    Chunk* chunk = current_.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        const size_t offset = chunk->offset.fetch_add(padded, std::memory_order_relaxed);
+        if (offset + padded <= chunk->capacity)
+        {
+            const auto address = reinterpret_cast<uintptr_t>(chunk->data.get() + offset);
+            return reinterpret_cast<void*>((address + alignment - 1) & ~(alignment - 1));
+        }
+
+        chunk = AddChunk(chunk, padded);
+    }
+}
+
+std::wstring_view FrameArena::CopyString(std::wstring_view text)
+{
+    if (text.empty()) return {};
+
+    auto* characters = static_cast<wchar_t*>(Allocate(text.size() * sizeof(wchar_t), alignof(wchar_t)));
+    std::memcpy(characters, text.data(), text.size() * sizeof(wchar_t));
+    return {characters, text.size()};
+}
+
+void FrameArena::Reset()
+{
+    std::lock_guard lock(mutex_);
+
+    // A frame that spilled into extra chunks gets one chunk big enough for all of them next time.
+    if (chunks_.size() > 1)
+    {
+        size_t total = 0;
+        for (const auto& chunk : chunks_)
+            total += chunk->capacity;
+
+        chunks_.clear();
+        chunkSize_ = total;
+
+        auto chunk = std::make_unique<Chunk>();
+        chunk->data = std::make_unique_for_overwrite<std::byte[]>(chunkSize_);
+        chunk->capacity = chunkSize_;
+        chunks_.push_back(std::move(chunk));
+    }
+
+    chunks_.front()->offset.store(0, std::memory_order_relaxed);
+    current_.store(chunks_.front().get(), std::memory_order_release);
+}
+
+size_t FrameArena::GetUsedBytes() const
+{
+    std::lock_guard lock(mutex_);
+
+    size_t used = 0;
+    for (const auto& chunk : chunks_)
+        used += std::min(chunk->offset.load(std::memory_order_relaxed), chunk->capacity);
+    return used;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    std::lock_guard lock(mutex_);
+
+    size_t capacity = 0;
+    for (const auto& chunk : chunks_)
+        capacity += chunk->capacity;
+    return capacity;
+}
+
+FrameArena::Chunk* FrameArena::AddChunk(const Chunk* full, size_t minSize)
+{
+    std::lock_guard lock(mutex_);
+
+    Chunk* current = current_.load(std::memory_order_acquire);
+    if (current != full) return current;
+
+    auto chunk = std::make_unique<Chunk>();
+    chunk->capacity = std::max(chunkSize_, minSize);
+    chunk->data = std::make_unique_for_overwrite<std::byte[]>(chunk->capacity);
+
+    current = chunk.get();
+    chunks_.push_back(std::move(chunk));
+    current_.store(current, std::memory_order_release);
+    return current;
+}
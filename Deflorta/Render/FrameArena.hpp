@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// Bump allocator for payloads that only live as long as one frame packet. Allocation is lock-free
+// unless a chunk runs out; Reset must only be called once no thread is allocating.
+class FrameArena final
+{
+public:
+    explicit FrameArena(size_t chunkSize = 64 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    std::wstring_view CopyString(std::wstring_view text);
+
+    void Reset();
+
+    [[nodiscard]] size_t GetUsedBytes() const;
+    [[nodiscard]] size_t GetCapacity() const;
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> data;
+        size_t capacity = 0;
+        std::atomic<size_t> offset = 0;
+    };
+
+    Chunk* AddChunk(const Chunk* full, size_t minSize);
+
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::atomic<Chunk*> current_ = nullptr;
+    mutable std::mutex mutex_;
+    size_t chunkSize_;
+};
@@ -0,0 +1,200 @@
+#include "GlobalAtlas.hpp"
+
+#include "IRenderBackend.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+IRenderBackend* GlobalAtlas::backend_ = nullptr;
+bool GlobalAtlas::enabled_ = true;
+std::vector<std::unique_ptr<GlobalAtlas::Page>> GlobalAtlas::pages_;
+std::unordered_map<std::string, std::shared_ptr<const AtlasEntry>> GlobalAtlas::entries_;
+std::mutex GlobalAtlas::mutex_;
+
+namespace
+{
+    // Surrounds data with copies of its edge pixels so linear filtering at the region border blends
+    // towards the image itself rather than towards transparent padding.
+    PixelData ExtrudeEdges(const PixelData& data, uint32_t padding)
+    {
+        PixelData out;
+        out.width = data.width + padding * 2;
+        out.height = data.height + padding * 2;
+        out.pitch = out.width * 4;
+        out.pixels.resize(static_cast<size_t>(out.pitch) * out.height);
+
+        const uint32_t srcPitch = data.pitch ? data.pitch : data.width * 4;
+        for (uint32_t y = 0; y < out.height; ++y)
+        {
+            const uint32_t srcY = std::clamp(y, padding, padding + data.height - 1) - padding;
+            const uint8_t* src = data.pixels.data() + static_cast<size_t>(srcY) * srcPitch;
+            uint8_t* dst = out.pixels.data() + static_cast<size_t>(y) * out.pitch;
+
+            for (uint32_t x = 0; x < padding; ++x)
+            {
+                std::memcpy(dst + x * 4, src, 4);
+                std::memcpy(dst + (padding + data.width + x) * 4, src + (data.width - 1) * 4, 4);
+            }
+            std::memcpy(dst + padding * 4, src, data.width * 4);
+        }
+        return out;
+    }
+}
+
+void GlobalAtlas::SetRenderBackend(IRenderBackend* backend)
+{
+    std::lock_guard lock(mutex_);
+    backend_ = backend;
+}
+
+void GlobalAtlas::SetEnabled(bool enabled)
+{
+    std::lock_guard lock(mutex_);
+    enabled_ = enabled;
+}
+
+std::shared_ptr<const AtlasEntry> GlobalAtlas::Add(const std::string& id, const PixelData& data,
+                                                   const AtlasRegion* trimmedFrom)
+{
+    if (!CanHold(data.width, data.height)) return nullptr;
+
+    std::lock_guard lock(mutex_);
+    if (!backend_) return nullptr;
+
+    if (const auto it = entries_.find(id); it != entries_.end())
+        return it->second;
+
+    const uint32_t width = data.width + kPadding * 2;
+    const uint32_t height = data.height + kPadding * 2;
+
+    Page* page = nullptr;
+    MaxRectsPacker::Placement placement;
+    for (const auto& candidate : pages_)
+    {
+        if (candidate->packer.Insert(width, height, false, placement))
+        {
+            page = candidate.get();
+            break;
+        }
+    }
+
+    if (!page)
+    {
+        page = AddPage();
+        if (!page || !page->packer.Insert(width, height, false, placement))
+            return nullptr;
+    }
+
+    AtlasRegion region;
+    region.x = placement.x + kPadding;
+    region.y = placement.y + kPadding;
+    region.width = data.width;
+    region.height = data.height;
+    region.pixelSize = trimmedFrom ? trimmedFrom->pixelSize : glm::vec2(data.width, data.height);
+    region.trimX = trimmedFrom ? trimmedFrom->trimX : 0;
+    region.trimY = trimmedFrom ? trimmedFrom->trimY : 0;
+    region.uvMin = glm::vec2(region.x, region.y) / static_cast<float>(kPageSize);
+    region.uvMax = glm::vec2(region.x + region.width, region.y + region.height) / static_cast<float>(kPageSize);
+
+    {
+        RenderBackendLock backendLock(backend_);
+        if (!backend_->UpdateTexture(page->texture.get(), ExtrudeEdges(data, kPadding), placement.x, placement.y))
+        {
+            std::cerr << "GlobalAtlas: Failed to upload '" << id << "'\n";
+            return nullptr;
+        }
+    }
+
+    auto entry = std::make_shared<const AtlasEntry>(AtlasEntry{page->texture, region});
+    entries_.emplace(id, entry);
+    return entry;
+}
+
+std::shared_ptr<const AtlasEntry> GlobalAtlas::AddAlias(const std::string& id, const AtlasEntry& source,
+                                                        const AtlasRegion& trimmedFrom)
+{
+    AtlasEntry alias = source;
+    alias.region.trimX = trimmedFrom.trimX;
+    alias.region.trimY = trimmedFrom.trimY;
+    alias.region.pixelSize = trimmedFrom.pixelSize;
+
+    std::lock_guard lock(mutex_);
+    const auto [it, inserted] = entries_.try_emplace(id, std::make_shared<const AtlasEntry>(std::move(alias)));
+    return it->second;
+}
+
+std::shared_ptr<const AtlasEntry> GlobalAtlas::Find(const std::string& id)
+{
+    std::lock_guard lock(mutex_);
+    const auto it = entries_.find(id);
+    return it != entries_.end() ? it->second : nullptr;
+}
+
+std::string GlobalAtlas::FindId(const ITexture* page, const AtlasRegion& region)
+{
+    std::lock_guard lock(mutex_);
+    for (const auto& [id, entry] : entries_)
+    {
+        const auto& r = entry->region;
+        if (entry->page.get() == page && r.x == region.x && r.y == region.y && r.width == region.width &&
+            r.height == region.height && r.trimX == region.trimX && r.trimY == region.trimY)
+            return id;
+    }
+    return {};
+}
+
+std::shared_ptr<ITexture> GlobalAtlas::GetPage(size_t index)
+{
+    std::lock_guard lock(mutex_);
+    return index < pages_.size() ? pages_[index]->texture : nullptr;
+}
+
+bool GlobalAtlas::CanHold(uint32_t width, uint32_t height)
+{
+    std::lock_guard lock(mutex_);
+    return enabled_ && width > 0 && height > 0 && width <= kMaxImageSize && height <= kMaxImageSize;
+}
+
+size_t GlobalAtlas::GetPageCount()
+{
+    std::lock_guard lock(mutex_);
+    return pages_.size();
+}
+
+float GlobalAtlas::GetOccupancy()
+{
+    std::lock_guard lock(mutex_);
+    if (pages_.empty()) return 0.0f;
+
+    float total = 0.0f;
+    for (const auto& page : pages_)
+        total += page->packer.GetOccupancy();
+    return total / static_cast<float>(pages_.size());
+}
+
+GlobalAtlas::Page* GlobalAtlas::AddPage()
+{
+    PixelData blank;
+    blank.width = kPageSize;
+    blank.height = kPageSize;
+    blank.pitch = kPageSize * 4;
+    blank.pixels.assign(static_cast<size_t>(blank.pitch) * kPageSize, 0);
+
+    auto page = std::make_unique<Page>();
+    {
+        RenderBackendLock backendLock(backend_);
+        page->texture = backend_->CreateTexture(blank);
+    }
+
+    if (!page->texture)
+    {
+        std::cerr << "GlobalAtlas: Failed to create atlas page " << pages_.size() << "\n";
+        return nullptr;
+    }
+
+    page->texture->SetName("atlas:" + std::to_string(pages_.size()));
+    page->packer.Reset(kPageSize, kPageSize);
+    pages_.push_back(std::move(page));
+    return pages_.back().get();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "AtlasBuilder.hpp"
+#include "IRenderBackend.hpp"
+#include "MaxRectsPacker.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AtlasEntry
+{
+    std::shared_ptr<ITexture> page;
+    AtlasRegion region;
+};
+
+// Stands in for an image whose only copy lives in an atlas page; it has no backend texture of its
+// own, so it is drawn through its atlas entry.
+class AtlasTexture final : public ITexture
+{
+public:
+    explicit AtlasTexture(std::shared_ptr<const AtlasEntry> entry) { SetAtlasEntry(std::move(entry)); }
+
+    glm::vec2 GetSize() const override { return GetAtlasEntry()->region.pixelSize; }
+    void* GetNativeHandle() const override { return nullptr; }
+};
+
+// Shared atlas pages filled incrementally from reanim parts and resource-group images, so sprites
+// of different object types end up in the same few textures and batch together.
+class GlobalAtlas final
+{
+public:
+    static constexpr uint32_t kPageSize = 2048;
+    static constexpr uint32_t kMaxImageSize = 512;
+    static constexpr uint32_t kPadding = 1;
+
+    static void SetRenderBackend(IRenderBackend* backend);
+    static void SetEnabled(bool enabled);
+
+    // Returns the existing entry when the id is already packed, or null when disabled, when the
+    // image is too large for a page or when it cannot be uploaded. trimmedFrom carries the trim
+    // offset and untrimmed size of data when it was cut out of a baked atlas.
+    static std::shared_ptr<const AtlasEntry> Add(const std::string& id, const PixelData& data,
+                                                 const AtlasRegion* trimmedFrom = nullptr);
+    // Registers id as another name for source's pixels, with trimmedFrom's trim offset and size.
+    static std::shared_ptr<const AtlasEntry> AddAlias(const std::string& id, const AtlasEntry& source,
+                                                      const AtlasRegion& trimmedFrom);
+    static std::shared_ptr<const AtlasEntry> Find(const std::string& id);
+    // Returns the id whose entry occupies region on page, or an empty string when none does.
+    static std::string FindId(const ITexture* page, const AtlasRegion& region);
+    static bool CanHold(uint32_t width, uint32_t height);
+
+    static std::shared_ptr<ITexture> GetPage(size_t index);
+    static size_t GetPageCount();
+    static float GetOccupancy();
+
+private:
+    struct Page
+    {
+        MaxRectsPacker packer;
+        std::shared_ptr<ITexture> texture;
+    };
+
+    static Page* AddPage();
+
+    static IRenderBackend* backend_;
+    static bool enabled_;
+    static std::vector<std::unique_ptr<Page>> pages_;
+    static std::unordered_map<std::string, std::shared_ptr<const AtlasEntry>> entries_;
+    static std::mutex mutex_;
+};
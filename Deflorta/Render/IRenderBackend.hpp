@@ -5,8 +5,11 @@
 #include "../Base/Matrix.hpp"
 #include "../Base/Rect.hpp"
 
+#include <array>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 enum class Justification : std::uint8_t
 {
@@ -18,12 +21,31 @@ enum class Justification : std::uint8_t
     CenterVerticalMiddle
 };
 
+struct AtlasEntry;
+
 class ITexture
 {
 public:
     virtual ~ITexture() = default;
     virtual glm::vec2 GetSize() const = 0;
     virtual void* GetNativeHandle() const = 0;
+
+    const std::string& GetName() const { return name_; }
+    void SetName(std::string name) { name_ = std::move(name); }
+
+    // Optional pre-downscaled copies: level 1 is half size, level 2 quarter size.
+    static constexpr int kMaxMipLevel = 2;
+    const std::shared_ptr<ITexture>& GetMip(int level) const { return mips_[level - 1]; }
+    void SetMip(int level, std::shared_ptr<ITexture> mip) { mips_[level - 1] = std::move(mip); }
+
+    // Set when a copy of this texture also lives in a shared atlas page.
+    const std::shared_ptr<const AtlasEntry>& GetAtlasEntry() const { return atlasEntry_; }
+    void SetAtlasEntry(std::shared_ptr<const AtlasEntry> entry) { atlasEntry_ = std::move(entry); }
+
+private:
+    std::string name_;
+    std::array<std::shared_ptr<ITexture>, kMaxMipLevel> mips_;
+    std::shared_ptr<const AtlasEntry> atlasEntry_;
 };
 
 class ITextFormat
@@ -31,6 +53,19 @@ class ITextFormat
 public:
     virtual ~ITextFormat() = default;
     virtual void* GetNativeHandle() const = 0;
+
+    const std::wstring& GetFontFamily() const { return fontFamily_; }
+    float GetFontSize() const { return fontSize_; }
+
+    void SetDescription(std::wstring fontFamily, float fontSize)
+    {
+        fontFamily_ = std::move(fontFamily);
+        fontSize_ = fontSize;
+    }
+
+private:
+    std::wstring fontFamily_;
+    float fontSize_ = 0.0f;
 };
 
 class IRenderBackend
@@ -49,7 +84,16 @@ public:
     virtual void EndFrame() = 0;
     virtual void Clear(const Color& color) = 0;
 
+    // Limits the next frame to the given backbuffer rects; an empty list means a full redraw. Only honoured
+    // by backends that keep the previous frame's pixels, as reported by SupportsPartialRedraw.
+    virtual void SetDirtyRegion(const std::vector<Rect>& rects) = 0;
+    virtual bool SupportsPartialRedraw() const = 0;
+
     virtual std::shared_ptr<ITexture> CreateTexture(const PixelData& data) = 0;
+    virtual std::shared_ptr<ITexture> CreateRenderTarget(uint32_t width, uint32_t height) = 0;
+    // Overwrites the data-sized block at (x, y) of a texture made by CreateTexture.
+    virtual bool UpdateTexture(ITexture* texture, const PixelData& data, uint32_t x, uint32_t y) = 0;
+    virtual void SetRenderTarget(ITexture* target) = 0;
 
     virtual std::shared_ptr<ITextFormat> CreateTextFormat(
         const std::wstring& fontFamily,
@@ -57,19 +101,19 @@ public:
 
     virtual void DrawTexture(
         ITexture* texture,
-        const glm::mat3& transform,
+        const Affine2D& transform,
         float opacity,
         const Color& tint) = 0;
 
     virtual void DrawTextureRect(
         ITexture* texture,
-        const glm::mat3& transform,
+        const Affine2D& transform,
         const Rect& sourceRect,
         float opacity,
         const Color& tint) = 0;
 
     virtual void DrawTexts(
-        const std::wstring& text,
+        std::wstring_view text,
         const Rect& layoutRect,
         ITextFormat* textFormat,
         const Color& color,
@@ -81,8 +125,8 @@ public:
         float strokeWidth,
         bool filled = false) = 0;
 
-    virtual void SetTransform(const glm::mat3& transform) = 0;
-    virtual glm::mat3 GetTransform() const = 0;
+    virtual void SetTransform(const Affine2D& transform) = 0;
+    virtual Affine2D GetTransform() const = 0;
 
     virtual void Lock() = 0;
     virtual void Unlock() = 0;
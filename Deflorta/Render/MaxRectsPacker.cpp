@@ -0,0 +1,132 @@
+#include "MaxRectsPacker.hpp"
+
+#include <algorithm>
+#include <limits>
+
+void MaxRectsPacker::Reset(uint32_t width, uint32_t height)
+{
+    width_ = width;
+    height_ = height;
+    usedWidth_ = 0;
+    usedHeight_ = 0;
+    usedArea_ = 0;
+
+    freeRects_.clear();
+    freeRects_.push_back({0, 0, width, height});
+}
+
+bool MaxRectsPacker::Insert(uint32_t width, uint32_t height, bool allowRotation, Placement& outPlacement)
+{
+    if (width == 0 || height == 0) return false;
+
+    uint32_t bestShort = std::numeric_limits<uint32_t>::max();
+    uint32_t bestLong = std::numeric_limits<uint32_t>::max();
+    PackRect best;
+    bool bestRotated = false;
+
+    auto consider = [&](const PackRect& free, uint32_t w, uint32_t h, bool rotated)
+    {
+        if (w > free.width || h > free.height) return;
+
+        const uint32_t leftoverX = free.width - w;
+        const uint32_t leftoverY = free.height - h;
+        const uint32_t shortSide = std::min(leftoverX, leftoverY);
+        const uint32_t longSide = std::max(leftoverX, leftoverY);
+
+        if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+        {
+            bestShort = shortSide;
+            bestLong = longSide;
+            best = {free.x, free.y, w, h};
+            bestRotated = rotated;
+        }
+    };
+
+    for (const auto& free : freeRects_)
+    {
+        consider(free, width, height, false);
+        if (allowRotation && width != height)
+            consider(free, height, width, true);
+    }
+
+    if (best.width == 0) return false;
+
+    SplitFreeRects(best);
+
+    usedWidth_ = std::max(usedWidth_, best.x + best.width);
+    usedHeight_ = std::max(usedHeight_, best.y + best.height);
+    usedArea_ += static_cast<uint64_t>(best.width) * best.height;
+
+    outPlacement = {best.x, best.y, best.width, best.height, bestRotated};
+    return true;
+}
+
+float MaxRectsPacker::GetOccupancy() const
+{
+    const uint64_t area = static_cast<uint64_t>(width_) * height_;
+    return area ? static_cast<float>(usedArea_) / static_cast<float>(area) : 0.0f;
+}
+
+bool MaxRectsPacker::Contains(const PackRect& outer, const PackRect& inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y &&
+        inner.x + inner.width <= outer.x + outer.width &&
+        inner.y + inner.height <= outer.y + outer.height;
+}
+
+void MaxRectsPacker::SplitFreeRects(const PackRect& used)
+{
+    scratch_.clear();
+
+    for (const auto& free : freeRects_)
+    {
+        const uint32_t freeRight = free.x + free.width;
+        const uint32_t freeBottom = free.y + free.height;
+        const uint32_t usedRight = used.x + used.width;
+        const uint32_t usedBottom = used.y + used.height;
+
+        if (used.x >= freeRight || usedRight <= free.x || used.y >= freeBottom || usedBottom <= free.y)
+        {
+            scratch_.push_back(free);
+            continue;
+        }
+
+        if (used.x > free.x)
+            scratch_.push_back({free.x, free.y, used.x - free.x, free.height});
+        if (usedRight < freeRight)
+            scratch_.push_back({usedRight, free.y, freeRight - usedRight, free.height});
+        if (used.y > free.y)
+            scratch_.push_back({free.x, free.y, free.width, used.y - free.y});
+        if (usedBottom < freeBottom)
+            scratch_.push_back({free.x, usedBottom, free.width, freeBottom - usedBottom});
+    }
+
+    std::swap(freeRects_, scratch_);
+    PruneFreeRects();
+}
+
+void MaxRectsPacker::PruneFreeRects()
+{
+    // Zero width marks a rectangle swallowed by another; they are compacted in one pass afterwards.
+    for (size_t i = 0; i < freeRects_.size(); ++i)
+    {
+        if (freeRects_[i].width == 0) continue;
+
+        for (size_t j = i + 1; j < freeRects_.size(); ++j)
+        {
+            if (freeRects_[j].width == 0) continue;
+
+            if (Contains(freeRects_[i], freeRects_[j]))
+            {
+                freeRects_[j].width = 0;
+            }
+            else if (Contains(freeRects_[j], freeRects_[i]))
+            {
+                freeRects_[i].width = 0;
+                break;
+            }
+        }
+    }
+
+    std::erase_if(freeRects_, [](const PackRect& rect) { return rect.width == 0; });
+}
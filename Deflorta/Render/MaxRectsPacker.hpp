@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// MaxRects bin packer using the best-short-side-fit heuristic. Free space is kept as a flat list
+// of maximal rectangles whose storage survives Reset, so retrying at another size allocates nothing.
+class MaxRectsPacker final
+{
+public:
+    struct Placement
+    {
+        uint32_t x = 0, y = 0;
+        uint32_t width = 0, height = 0;
+        bool rotated = false;
+    };
+
+    void Reset(uint32_t width, uint32_t height);
+    bool Insert(uint32_t width, uint32_t height, bool allowRotation, Placement& outPlacement);
+
+    [[nodiscard]] uint32_t GetWidth() const { return width_; }
+    [[nodiscard]] uint32_t GetHeight() const { return height_; }
+    [[nodiscard]] uint32_t GetUsedWidth() const { return usedWidth_; }
+    [[nodiscard]] uint32_t GetUsedHeight() const { return usedHeight_; }
+    [[nodiscard]] float GetOccupancy() const;
+
+private:
+    struct PackRect
+    {
+        uint32_t x = 0, y = 0;
+        uint32_t width = 0, height = 0;
+    };
+
+    static bool Contains(const PackRect& outer, const PackRect& inner);
+    void SplitFreeRects(const PackRect& used);
+    void PruneFreeRects();
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t usedWidth_ = 0;
+    uint32_t usedHeight_ = 0;
+    uint64_t usedArea_ = 0;
+    std::vector<PackRect> freeRects_;
+    std::vector<PackRect> scratch_;
+};
@@ -0,0 +1,89 @@
+#include "OverdrawMap.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr int32_t kMaxCount = std::numeric_limits<uint16_t>::max();
+
+    // Write count -> RGBA, clamped at the last entry.
+    constexpr std::array<std::array<uint8_t, 4>, 9> kHeatRamp = {{
+        {0, 0, 0, 255},
+        {0, 0, 160, 255},
+        {0, 110, 255, 255},
+        {0, 200, 90, 255},
+        {170, 230, 0, 255},
+        {255, 200, 0, 255},
+        {255, 110, 0, 255},
+        {230, 0, 0, 255},
+        {255, 255, 255, 255},
+    }};
+}
+
+void OverdrawMap::Begin(uint32_t width, uint32_t height)
+{
+    width_ = width;
+    height_ = height;
+    deltas_.assign(static_cast<size_t>(width_ + 1) * (height_ + 1), 0);
+    totalWrites_ = 0;
+    maxCount_ = 0;
+}
+
+void OverdrawMap::Accumulate(const Rect& rect)
+{
+    const auto x0 = static_cast<uint32_t>(std::clamp(std::floor(rect.Left()), 0.0f, static_cast<float>(width_)));
+    const auto y0 = static_cast<uint32_t>(std::clamp(std::floor(rect.Top()), 0.0f, static_cast<float>(height_)));
+    const auto x1 = static_cast<uint32_t>(std::clamp(std::ceil(rect.Right()), 0.0f, static_cast<float>(width_)));
+    const auto y1 = static_cast<uint32_t>(std::clamp(std::ceil(rect.Bottom()), 0.0f, static_cast<float>(height_)));
+    if (x0 >= x1 || y0 >= y1) return;
+
+    const size_t stride = width_ + 1;
+    ++deltas_[y0 * stride + x0];
+    --deltas_[y0 * stride + x1];
+    --deltas_[y1 * stride + x0];
+    ++deltas_[y1 * stride + x1];
+}
+
+void OverdrawMap::Resolve()
+{
+    const size_t stride = width_ + 1;
+    counts_.resize(static_cast<size_t>(width_) * height_);
+
+    for (uint32_t y = 0; y < height_; ++y)
+    {
+        int32_t row = 0;
+        for (uint32_t x = 0; x < width_; ++x)
+        {
+            row += deltas_[y * stride + x];
+            // Adding the cell above turns the row sums into the full 2D prefix sum of the deltas.
+            const int32_t value = row + (y > 0 ? static_cast<int32_t>(counts_[(y - 1) * width_ + x]) : 0);
+            const auto count = static_cast<uint16_t>(std::clamp<int32_t>(value, 0, kMaxCount));
+            counts_[y * width_ + x] = count;
+            totalWrites_ += count;
+            maxCount_ = std::max<uint32_t>(maxCount_, count);
+        }
+    }
+}
+
+float OverdrawMap::GetOverdrawFactor() const
+{
+    const size_t pixels = static_cast<size_t>(width_) * height_;
+    return pixels ? static_cast<float>(static_cast<double>(totalWrites_) / static_cast<double>(pixels)) : 0.0f;
+}
+
+void OverdrawMap::BuildHeatmap(PixelData& out) const
+{
+    out.width = width_;
+    out.height = height_;
+    out.pitch = width_ * 4;
+    out.pixels.resize(static_cast<size_t>(out.pitch) * height_);
+
+    for (size_t i = 0; i < counts_.size(); ++i)
+    {
+        const auto& color = kHeatRamp[std::min<size_t>(counts_[i], kHeatRamp.size() - 1)];
+        std::copy(color.begin(), color.end(), out.pixels.begin() + static_cast<std::ptrdiff_t>(i * 4));
+    }
+}
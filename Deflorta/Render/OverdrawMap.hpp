@@ -0,0 +1,30 @@
+#pragma once
+
+#include "PixelData.hpp"
+#include "../Base/Rect.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Per-pixel write counts for one frame, accumulated from draw bounds. Rects are added to a 2D
+// difference table and resolved with a single prefix-sum pass, so cost is O(items + pixels).
+class OverdrawMap final
+{
+public:
+    void Begin(uint32_t width, uint32_t height);
+    void Accumulate(const Rect& rect);
+    void Resolve();
+
+    [[nodiscard]] float GetOverdrawFactor() const;
+    [[nodiscard]] uint32_t GetMaxCount() const { return maxCount_; }
+    // Fills out with the heat colors, reusing its pixel buffer when the size is unchanged.
+    void BuildHeatmap(PixelData& out) const;
+
+private:
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    std::vector<int32_t> deltas_;
+    std::vector<uint16_t> counts_;
+    uint64_t totalWrites_ = 0;
+    uint32_t maxCount_ = 0;
+};
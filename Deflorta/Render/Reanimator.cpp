@@ -1,6 +1,7 @@
 #include "Reanimator.hpp"
 
 #include "../Resource/ResourceManager.hpp"
+#include "GlobalAtlas.hpp"
 #include "Renderer.hpp"
 #include "../Base/Time.hpp"
 
@@ -15,6 +16,7 @@ Reanimator::Reanimator(const ReanimatorDefinition* def)
     frameStart_ = 0;
     frameCount_ = !def->tracks.empty() ? static_cast<int>(def->tracks.front().transforms.size()) : 0;
     tracks_.resize(def->tracks.size());
+    imageCache_.resize(def->tracks.size());
 }
 
 bool Reanimator::IsFinished() const
@@ -379,18 +381,7 @@ void Reanimator::Draw() const
                     tint = globalTint_;
                 }
 
-                if (def_->useAtlas && def_->atlasTexture)
-                {
-                    auto it = def_->atlasRegions.find(cur.image);
-                    if (it != def_->atlasRegions.end())
-                    {
-                        Renderer::EnqueueReanimAtlas(def_->atlasTexture, cur, it->second, z, opacity, tint);
-                    }
-                }
-                else if (auto bmp = ResourceManager::GetImage(cur.image))
-                {
-                    Renderer::EnqueueReanim(bmp, cur, z, opacity, tint);
-                }
+                EnqueueTrackImage(ti, cur, z, opacity, tint);
             }
             else if (!cur.text.empty() && !cur.font.empty())
             {
@@ -450,18 +441,7 @@ void Reanimator::Draw() const
                     tint = globalTint_;
                 }
 
-                if (def_->useAtlas && def_->atlasTexture)
-                {
-                    auto it = def_->atlasRegions.find(cur.image);
-                    if (it != def_->atlasRegions.end())
-                    {
-                        Renderer::EnqueueReanimAtlas(def_->atlasTexture, cur, it->second, z, opacity, tint);
-                    }
-                }
-                else if (auto bmp = ResourceManager::GetImage(cur.image))
-                {
-                    Renderer::EnqueueReanim(bmp, cur, z, opacity, tint);
-                }
+                EnqueueTrackImage(ti, cur, z, opacity, tint);
             }
             else if (!cur.text.empty() && !cur.font.empty())
             {
@@ -483,6 +463,38 @@ void Reanimator::Draw() const
     }
 }
 
+void Reanimator::EnqueueTrackImage(size_t track, const ReanimatorTransform& transform, int z, float opacity,
+                                   const Color& tint) const
+{
+    // Track images only change on keyframes, so the lookup is redone only when the name differs.
+    auto& cache = imageCache_[track];
+    if (cache.image != transform.image)
+    {
+        cache.image = transform.image;
+        const auto it = def_->atlasEntries.find(transform.image);
+        cache.atlas = it != def_->atlasEntries.end() ? &it->second : nullptr;
+        cache.handle = cache.atlas ? ResourceHandle{} : ResourceManager::GetImageHandle(transform.image);
+        cache.pending = !cache.atlas && !cache.handle.IsValid() && ResourceManager::IsImageQueued(transform.image);
+    }
+
+    if (cache.atlas)
+    {
+        Renderer::EnqueueReanimAtlas(cache.atlas->page, transform, cache.atlas->region, z, opacity, tint);
+        return;
+    }
+
+    const auto* texture = &ResourceManager::ResolveImage(cache.handle);
+    if (!*texture && (cache.handle.IsValid() || cache.pending))
+    {
+        cache.handle = ResourceManager::GetImageHandle(transform.image);
+        cache.pending = !cache.handle.IsValid() && ResourceManager::IsImageQueued(transform.image);
+        texture = &ResourceManager::ResolveImage(cache.handle);
+    }
+
+    if (*texture)
+        Renderer::EnqueueReanim(*texture, transform, z, opacity, tint);
+}
+
 void Reanimator::SetPosition(glm::vec2 pos)
 {
     overlay_.position = pos;
@@ -2,6 +2,7 @@
 
 #include "Layer.hpp"
 #include "../Resource/ReanimationLoader.hpp"
+#include "../Resource/ResourceHandle.hpp"
 #include "../Base/Transform.hpp"
 
 #include <string>
@@ -38,6 +39,15 @@ struct TrackInstance
     Color tint = Color::White;
 };
 
+struct TrackImageCache
+{
+    std::string image;
+    const AtlasEntry* atlas = nullptr;
+    ResourceHandle handle;
+    // The image was missed on a scene worker and is loading in the background.
+    bool pending = false;
+};
+
 class Reanimator final
 {
 public:
@@ -82,6 +92,8 @@ private:
     int FindTrackIndexByName(const std::string& trackName) const;
 
     [[nodiscard]] FrameTime GetFrameTime() const;
+    void EnqueueTrackImage(size_t track, const ReanimatorTransform& transform, int z, float opacity,
+                           const Color& tint) const;
     static ReanimatorTransform LerpTransform(const ReanimatorTransform& a,
                                              const ReanimatorTransform& b,
                                              float t);
@@ -100,6 +112,7 @@ private:
 
     Transform overlay_{};
     std::vector<TrackInstance> tracks_;
+    mutable std::vector<TrackImageCache> imageCache_;
 
     Color globalTint_ = Color::White;
 
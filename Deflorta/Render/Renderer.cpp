@@ -1,23 +1,240 @@
 #include "Renderer.hpp"
 
 #include "D2DRenderBackend.hpp"
+#include "DrawCapture.hpp"
+#include "GlobalAtlas.hpp"
+#include "SoftwareRenderBackend.hpp"
+#include "../Base/ThreadPool.hpp"
 #include "../Base/Time.hpp"
 #include "../Resource/ReanimationLoader.hpp"
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
 #include <format>
+#include <iostream>
+#include <iterator>
 #include <numbers>
+#include <unordered_map>
 
 std::unique_ptr<IRenderBackend> Renderer::backend_;
 bool Renderer::showFPS_ = false;
+bool Renderer::showStats_ = false;
+std::atomic<bool> Renderer::showOverdraw_ = false;
+OverdrawMap Renderer::overdrawMap_;
+PixelData Renderer::overdrawPixels_;
+std::shared_ptr<ITexture> Renderer::overdrawTexture_;
+std::shared_ptr<ITextFormat> Renderer::overlayFormat_;
 std::vector<DrawItem> Renderer::drawQueue_;
-size_t Renderer::submitSeq_ = 0;
+std::atomic<uint64_t> Renderer::submitSeq_ = 0;
+std::atomic<uint32_t> Renderer::culledCount_ = 0;
+Rect Renderer::viewport_(0.0f, 0.0f, 1280.0f, 720.0f);
+std::atomic<bool> Renderer::textureBatching_ = false;
+std::vector<DrawItem> Renderer::batchScratch_;
+std::atomic<bool> Renderer::partialRedraw_ = false;
+std::atomic<bool> Renderer::forceFullRedraw_ = true;
+std::vector<uint64_t> Renderer::tileHashes_;
+std::vector<uint64_t> Renderer::previousTileHashes_;
+std::vector<uint8_t> Renderer::dirtyTiles_;
+std::vector<Rect> Renderer::dirtyRects_;
+uint32_t Renderer::dirtyTilesX_ = 0;
+uint32_t Renderer::dirtyTilesY_ = 0;
+std::chrono::steady_clock::time_point Renderer::lastFrameTime_;
+std::atomic<float> Renderer::renderScale_ = 1.0f;
+std::atomic<bool> Renderer::dynamicResolution_ = false;
+std::atomic<float> Renderer::targetFrameMs_ = 1000.0f / 60.0f;
+std::atomic<uint32_t> Renderer::backendGeneration_ = 0;
+double Renderer::averageFrameMs_ = 0.0;
+uint32_t Renderer::scaleCooldown_ = 0;
+std::shared_ptr<ITexture> Renderer::sceneTarget_;
+ITexture* Renderer::frameTarget_ = nullptr;
+RenderStats Renderer::lastStats_;
+std::mutex Renderer::statsMutex_;
+std::unique_ptr<DrawCapture> Renderer::capture_;
+std::string Renderer::capturePath_;
+uint32_t Renderer::captureFramesLeft_ = 0;
+std::mutex Renderer::captureMutex_;
+std::vector<std::unique_ptr<DrawCommandBuffer>> Renderer::threadBuffers_;
+std::mutex Renderer::threadBuffersMutex_;
+std::thread Renderer::renderThread_;
+std::mutex Renderer::packetMutex_;
+std::condition_variable Renderer::packetReady_;
+std::condition_variable Renderer::packetConsumed_;
+std::deque<FramePacket> Renderer::pendingPackets_;
+std::vector<std::vector<DrawItem>> Renderer::freeItemBuffers_;
+std::unique_ptr<FrameArena> Renderer::frameArena_;
+std::vector<std::unique_ptr<FrameArena>> Renderer::freeArenas_;
+size_t Renderer::arenaHighWater_ = 0;
+uint32_t Renderer::maxQueuedFrames_ = 1;
+uint32_t Renderer::peakQueuedFrames_ = 0;
+bool Renderer::renderThreadRunning_ = false;
+std::deque<Renderer::PendingUpload> Renderer::pendingUploads_;
+std::condition_variable Renderer::uploadsDone_;
+std::thread::id Renderer::backendThread_;
+
+namespace
+{
+    thread_local DrawCommandBuffer* t_drawBuffer = nullptr;
+    thread_local std::vector<DrawItem>* t_captureTarget = nullptr;
+
+    struct TextFormatKey
+    {
+        std::wstring family;
+        float size = 0.0f;
+    };
+
+    struct TextFormatView
+    {
+        std::wstring_view family;
+        float size = 0.0f;
+    };
+
+    // Transparent so lookups by view never build a key string.
+    struct TextFormatHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(const TextFormatView& key) const
+        {
+            return std::hash<std::wstring_view>{}(key.family) ^ std::hash<float>{}(key.size) * 31;
+        }
+
+        size_t operator()(const TextFormatKey& key) const { return (*this)(TextFormatView{key.family, key.size}); }
+    };
+
+    struct TextFormatEqual
+    {
+        using is_transparent = void;
+
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) const
+        {
+            return a.size == b.size && std::wstring_view(a.family) == std::wstring_view(b.family);
+        }
+    };
+
+    // Formats already handed out by the backend, kept per submitting thread so text enqueues skip the backend lock.
+    struct TextFormatCache
+    {
+        uint32_t generation = 0;
+        std::unordered_map<TextFormatKey, std::shared_ptr<ITextFormat>, TextFormatHash, TextFormatEqual> formats;
+    };
+
+    thread_local TextFormatCache t_textFormats;
+
+    // How many batches back a draw may hop to join an earlier draw using the same texture.
+    constexpr size_t kBatchLookback = 32;
+
+    // Menu frames are compared in tiles of this size to find the regions that changed.
+    constexpr uint32_t kDirtyTileSize = 64;
+    constexpr uint64_t kTileHashSeed = 0xcbf29ce484222325ull;
+    constexpr auto kIdleFrameInterval = std::chrono::microseconds(16667);
+
+    constexpr float kMinRenderScale = 0.5f;
+    constexpr float kRenderScaleStep = 0.05f;
+    // Frames to wait after a scale change before judging the new frame time.
+    constexpr uint32_t kScaleCooldownFrames = 30;
+
+    Rect Union(const Rect& a, const Rect& b)
+    {
+        return Rect::FromMinMax(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+
+    struct TileSpan
+    {
+        uint32_t x0, y0, x1, y1;
+    };
+
+    TileSpan ToTileSpan(const Rect& bounds, uint32_t tilesX, uint32_t tilesY)
+    {
+        constexpr auto tile = static_cast<float>(kDirtyTileSize);
+        return {
+            static_cast<uint32_t>(std::max(0.0f, bounds.min.x / tile)),
+            static_cast<uint32_t>(std::max(0.0f, bounds.min.y / tile)),
+            std::min(tilesX, static_cast<uint32_t>(std::max(0.0f, std::ceil(bounds.max.x / tile)))),
+            std::min(tilesY, static_cast<uint32_t>(std::max(0.0f, std::ceil(bounds.max.y / tile))))
+        };
+    }
+
+    void HashCombine(uint64_t& hash, uint64_t value)
+    {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    }
+
+    void HashFloat(uint64_t& hash, float value)
+    {
+        HashCombine(hash, std::bit_cast<uint32_t>(value));
+    }
+
+    void HashRect(uint64_t& hash, const Rect& rect)
+    {
+        HashFloat(hash, rect.min.x);
+        HashFloat(hash, rect.min.y);
+        HashFloat(hash, rect.max.x);
+        HashFloat(hash, rect.max.y);
+    }
+
+    void HashColor(uint64_t& hash, const Color& color)
+    {
+        HashFloat(hash, color.value.r);
+        HashFloat(hash, color.value.g);
+        HashFloat(hash, color.value.b);
+        HashFloat(hash, color.value.a);
+    }
+
+    void HashAffine(uint64_t& hash, const Affine2D& m)
+    {
+        HashFloat(hash, m.m11);
+        HashFloat(hash, m.m12);
+        HashFloat(hash, m.m21);
+        HashFloat(hash, m.m22);
+        HashFloat(hash, m.dx);
+        HashFloat(hash, m.dy);
+    }
+
+    // Trimmed regions start inside the sprite; rotated ones are stored turned clockwise. Both map
+    // packed texels back to sprite space before the sprite transform.
+    Affine2D ToPackedSpace(Affine2D mat, const AtlasRegion& region)
+    {
+        if (region.trimX || region.trimY)
+            mat = mat * MatrixHelper::Translation(glm::vec2(region.trimX, region.trimY));
+        if (region.rotated)
+            mat = mat * MatrixHelper::CreateMatrix(0.0f, -1.0f, 1.0f, 0.0f, 0.0f, static_cast<float>(region.height));
+        return mat;
+    }
+
+    Rect PackedRect(const AtlasRegion& region)
+    {
+        return Rect(region.x, region.y, region.x + region.PackedWidth(), region.y + region.PackedHeight());
+    }
+}
+
+DrawRecordScope::DrawRecordScope(uint32_t key)
+    : buffer_(Renderer::GetThreadBuffer())
+{
+    previousKey_ = buffer_->recordKey;
+    previousSeq_ = buffer_->localSeq;
+    previousRecording_ = buffer_->recording;
+
+    buffer_->recordKey = static_cast<uint64_t>(key) << 32;
+    buffer_->localSeq = 0;
+    buffer_->recording = true;
+}
+
+DrawRecordScope::~DrawRecordScope()
+{
+    buffer_->recordKey = previousKey_;
+    buffer_->localSeq = previousSeq_;
+    buffer_->recording = previousRecording_;
+}
 
 DrawItem::DrawItem(const DrawItem& other)
 {
     opacity = other.opacity;
     z = other.z;
     seq = other.seq;
+    bounds = other.bounds;
     drawType = other.drawType;
     if (drawType == DrawType::Image)
     {
@@ -35,6 +252,10 @@ DrawItem::DrawItem(const DrawItem& other)
     {
         new(&data.rectangle) RectangleData(other.data.rectangle);
     }
+    else if (drawType == DrawType::CachedLayer)
+    {
+        new(&data.cachedLayer) CachedLayerData(other.data.cachedLayer);
+    }
 }
 
 DrawItem::DrawItem(DrawItem&& other) noexcept
@@ -42,6 +263,7 @@ DrawItem::DrawItem(DrawItem&& other) noexcept
     opacity = other.opacity;
     z = other.z;
     seq = other.seq;
+    bounds = other.bounds;
     drawType = other.drawType;
     if (drawType == DrawType::Image)
     {
@@ -59,6 +281,10 @@ DrawItem::DrawItem(DrawItem&& other) noexcept
     {
         new(&data.rectangle) RectangleData(other.data.rectangle);
     }
+    else if (drawType == DrawType::CachedLayer)
+    {
+        new(&data.cachedLayer) CachedLayerData(std::move(other.data.cachedLayer));
+    }
 }
 
 DrawItem& DrawItem::operator=(const DrawItem& other)
@@ -68,6 +294,7 @@ DrawItem& DrawItem::operator=(const DrawItem& other)
     opacity = other.opacity;
     z = other.z;
     seq = other.seq;
+    bounds = other.bounds;
     drawType = other.drawType;
     if (drawType == DrawType::Image)
     {
@@ -85,6 +312,10 @@ DrawItem& DrawItem::operator=(const DrawItem& other)
     {
         new(&data.rectangle) RectangleData(other.data.rectangle);
     }
+    else if (drawType == DrawType::CachedLayer)
+    {
+        new(&data.cachedLayer) CachedLayerData(other.data.cachedLayer);
+    }
     return *this;
 }
 
@@ -95,6 +326,7 @@ DrawItem& DrawItem::operator=(DrawItem&& other) noexcept
     opacity = other.opacity;
     z = other.z;
     seq = other.seq;
+    bounds = other.bounds;
     drawType = other.drawType;
     if (drawType == DrawType::Image)
     {
@@ -112,6 +344,10 @@ DrawItem& DrawItem::operator=(DrawItem&& other) noexcept
     {
         new(&data.rectangle) RectangleData(other.data.rectangle);
     }
+    else if (drawType == DrawType::CachedLayer)
+    {
+        new(&data.cachedLayer) CachedLayerData(std::move(other.data.cachedLayer));
+    }
     return *this;
 }
 
@@ -129,20 +365,35 @@ void DrawItem::DestroyActive()
     {
         data.imageAtlas.~ImageAtlasData();
     }
+    else if (drawType == DrawType::CachedLayer)
+    {
+        data.cachedLayer.~CachedLayerData();
+    }
     else
     {
         data.image.~ImageData();
     }
 }
 
-bool Renderer::Initialize(void* windowHandle)
+bool Renderer::Initialize(void* windowHandle, RenderBackendType backendType, bool useRenderThread)
 {
-    backend_ = std::make_unique<D2DRenderBackend>();
-    return backend_->Initialize(windowHandle);
+    if (backendType == RenderBackendType::Software)
+        backend_ = std::make_unique<SoftwareRenderBackend>();
+    else
+        backend_ = std::make_unique<D2DRenderBackend>();
+    ++backendGeneration_;
+    if (!backend_->Initialize(windowHandle))
+        return false;
+
+    if (useRenderThread)
+        StartRenderThread();
+    return true;
 }
 
 void Renderer::Resize(uint32_t width, uint32_t height)
 {
+    viewport_ = Rect(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height));
+    forceFullRedraw_ = true;
     if (backend_)
         backend_->Resize(width, height);
 }
@@ -152,29 +403,423 @@ void Renderer::BeginFrame()
     if (!backend_) return;
 
     drawQueue_.clear();
+    {
+        std::lock_guard lock(packetMutex_);
+        if (drawQueue_.capacity() == 0 && !freeItemBuffers_.empty())
+        {
+            drawQueue_ = std::move(freeItemBuffers_.back());
+            freeItemBuffers_.pop_back();
+        }
+        if (!frameArena_ && !freeArenas_.empty())
+        {
+            frameArena_ = std::move(freeArenas_.back());
+            freeArenas_.pop_back();
+        }
+    }
     if (drawQueue_.capacity() < 4096)
         drawQueue_.reserve(4096);
+    if (!frameArena_)
+        frameArena_ = std::make_unique<FrameArena>();
+    frameArena_->Reset();
     submitSeq_ = 0;
+    culledCount_ = 0;
 
-    backend_->BeginFrame();
-    backend_->Clear(Color::Black);
+    {
+        std::lock_guard lock(threadBuffersMutex_);
+        for (const auto& buffer : threadBuffers_)
+            buffer->items.clear();
+    }
 }
 
 void Renderer::Render()
 {
     if (!backend_) return;
 
-    FlushDrawQueue();
-    DrawFPS();
+    MergeThreadBuffers();
+
+    FramePacket packet;
+    packet.items = std::move(drawQueue_);
+    packet.arena = std::move(frameArena_);
+    packet.stats.drawItems = static_cast<uint32_t>(packet.items.size());
+    packet.stats.culledItems = culledCount_.exchange(0);
+    if (packet.arena)
+    {
+        packet.stats.arenaBytes = packet.arena->GetUsedBytes();
+        arenaHighWater_ = std::max(arenaHighWater_, packet.stats.arenaBytes);
+    }
+    packet.stats.arenaHighWater = arenaHighWater_;
+    packet.showFPS = showFPS_;
+    packet.showStats = showStats_;
+    packet.showOverdraw = showOverdraw_;
+    packet.renderScale = renderScale_;
+    packet.viewport = viewport_;
+    packet.partialRedraw = partialRedraw_ && !forceFullRedraw_.exchange(false);
+    packet.fps = Time::GetFps();
+    drawQueue_ = {};
 
-    backend_->EndFrame();
+    std::unique_lock lock(packetMutex_);
+    if (!renderThreadRunning_)
+    {
+        backendThread_ = std::this_thread::get_id();
+        lock.unlock();
+        ExecuteFrame(packet);
+        drawQueue_ = std::move(packet.items);
+        frameArena_ = std::move(packet.arena);
+        return;
+    }
+
+    packetConsumed_.wait(lock, []
+    {
+        return pendingPackets_.size() < maxQueuedFrames_ || !renderThreadRunning_;
+    });
+    packet.stats.queuedFrames = static_cast<uint32_t>(pendingPackets_.size() + 1);
+    peakQueuedFrames_ = std::max(peakQueuedFrames_, packet.stats.queuedFrames);
+    packet.stats.peakQueuedFrames = peakQueuedFrames_;
+    pendingPackets_.push_back(std::move(packet));
+    lock.unlock();
+    packetReady_.notify_one();
 }
 
 void Renderer::Cleanup()
 {
+    StopRenderThread();
+    {
+        std::lock_guard lock(packetMutex_);
+        backendThread_ = {};
+    }
+    RunPendingUploads(true);
+
+    overlayFormat_.reset();
+    sceneTarget_.reset();
+    overdrawTexture_.reset();
     if (backend_)
         backend_->Shutdown();
     backend_.reset();
+    ++backendGeneration_;
+
+    drawQueue_.clear();
+    freeItemBuffers_.clear();
+    frameArena_.reset();
+    freeArenas_.clear();
+}
+
+void Renderer::SetMaxQueuedFrames(uint32_t count)
+{
+    {
+        std::lock_guard lock(packetMutex_);
+        maxQueuedFrames_ = std::max(1u, count);
+    }
+    packetConsumed_.notify_all();
+}
+
+bool Renderer::IsRenderThreadRunning()
+{
+    std::lock_guard lock(packetMutex_);
+    return renderThreadRunning_;
+}
+
+void Renderer::RunOnBackendThread(std::vector<std::function<void()>> tasks)
+{
+    if (tasks.empty()) return;
+
+    std::unique_lock lock(packetMutex_);
+    if (backendThread_ == std::thread::id{} || backendThread_ == std::this_thread::get_id())
+    {
+        lock.unlock();
+        for (auto& task : tasks)
+            task();
+        return;
+    }
+
+    size_t remaining = tasks.size();
+    for (auto& task : tasks)
+        pendingUploads_.push_back({std::move(task), &remaining});
+    packetReady_.notify_one();
+    uploadsDone_.wait(lock, [&remaining] { return remaining == 0; });
+}
+
+void Renderer::PumpBackendTasks()
+{
+    // Lets the backend thread make progress on queued uploads while it blocks on something else.
+    {
+        std::lock_guard lock(packetMutex_);
+        if (backendThread_ != std::this_thread::get_id()) return;
+    }
+    RunPendingUploads(true);
+}
+
+void Renderer::RunPendingUploads(bool drainAll)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_lock lock(packetMutex_);
+    while (!pendingUploads_.empty())
+    {
+        auto upload = std::move(pendingUploads_.front());
+        pendingUploads_.pop_front();
+        lock.unlock();
+
+        upload.task();
+
+        lock.lock();
+        if (--*upload.remaining == 0)
+            uploadsDone_.notify_all();
+
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (!drainAll && elapsed.count() >= kUploadBudgetMs) break;
+    }
+}
+
+void Renderer::StartRenderThread()
+{
+    std::lock_guard lock(packetMutex_);
+    if (renderThreadRunning_) return;
+
+    renderThreadRunning_ = true;
+    renderThread_ = std::thread(RenderThreadLoop);
+}
+
+void Renderer::StopRenderThread()
+{
+    {
+        std::lock_guard lock(packetMutex_);
+        if (!renderThreadRunning_) return;
+        renderThreadRunning_ = false;
+    }
+    packetReady_.notify_all();
+    packetConsumed_.notify_all();
+
+    if (renderThread_.joinable())
+        renderThread_.join();
+
+    std::lock_guard lock(packetMutex_);
+    pendingPackets_.clear();
+}
+
+void Renderer::RenderThreadLoop()
+{
+    {
+        std::lock_guard lock(packetMutex_);
+        backendThread_ = std::this_thread::get_id();
+    }
+
+    while (true)
+    {
+        FramePacket packet;
+        {
+            std::unique_lock lock(packetMutex_);
+            packetReady_.wait(lock, []
+            {
+                return !renderThreadRunning_ || !pendingPackets_.empty() || !pendingUploads_.empty();
+            });
+            if (!renderThreadRunning_) return;
+            if (pendingPackets_.empty())
+            {
+                lock.unlock();
+                RunPendingUploads(false);
+                continue;
+            }
+
+            packet = std::move(pendingPackets_.front());
+            pendingPackets_.pop_front();
+        }
+        packetConsumed_.notify_one();
+
+        ExecuteFrame(packet);
+        RecyclePacket(packet);
+    }
+}
+
+void Renderer::RecyclePacket(FramePacket& packet)
+{
+    packet.items.clear();
+
+    std::lock_guard lock(packetMutex_);
+    if (freeItemBuffers_.size() <= maxQueuedFrames_)
+        freeItemBuffers_.push_back(std::move(packet.items));
+    if (packet.arena && freeArenas_.size() <= maxQueuedFrames_)
+        freeArenas_.push_back(std::move(packet.arena));
+}
+
+void Renderer::ExecuteFrame(FramePacket& packet)
+{
+    RunPendingUploads(false);
+    SortDrawQueue(packet.items, packet.stats);
+
+    // Overlays change every frame, so they force full redraws and drop the tile history.
+    const bool partial = packet.partialRedraw && !packet.showFPS && !packet.showStats && !packet.showOverdraw;
+    if (partial)
+        packet.stats.dirtyTiles = UpdateDirtyTiles(packet.items, packet.viewport);
+    else
+        previousTileHashes_.clear();
+
+    packet.stats.skippedFrame = partial && packet.stats.dirtyTiles == 0;
+    if (!packet.stats.skippedFrame)
+    {
+        const auto frameStart = std::chrono::steady_clock::now();
+        ITexture* sceneTarget = packet.renderScale < 1.0f
+                                    ? AcquireSceneTarget(packet.viewport, packet.renderScale)
+                                    : nullptr;
+        packet.stats.renderScale = sceneTarget ? packet.renderScale : 1.0f;
+
+        const bool dirtyOnly = partial && !sceneTarget && backend_->SupportsPartialRedraw();
+        static const std::vector<Rect> fullFrame;
+        backend_->SetDirtyRegion(dirtyOnly ? dirtyRects_ : fullFrame);
+
+        backend_->BeginFrame();
+        backend_->Clear(Color::Black);
+
+        if (sceneTarget)
+        {
+            // Draw the scene at reduced size into the offscreen target, then stretch it over the backbuffer.
+            const float scale = packet.renderScale;
+            const Affine2D downscale = MatrixHelper::Scale({scale, scale});
+            frameTarget_ = sceneTarget;
+            backend_->SetRenderTarget(sceneTarget);
+            backend_->Clear(Color::Black);
+            FlushDrawQueue(packet.items, packet.stats, false, &downscale);
+            frameTarget_ = nullptr;
+            backend_->SetRenderTarget(nullptr);
+            backend_->DrawTexture(sceneTarget, MatrixHelper::Scale({1.0f / scale, 1.0f / scale}), 1.0f,
+                                  Color::White);
+        }
+        else
+        {
+            FlushDrawQueue(packet.items, packet.stats, dirtyOnly, nullptr);
+        }
+
+        if (packet.showOverdraw)
+            DrawOverdraw(packet.items, packet.viewport, packet.stats);
+        DrawFPS(packet);
+        DrawStats(packet);
+
+        backend_->EndFrame();
+        UpdateDynamicResolution(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+    }
+    else
+    {
+        // Nothing to present, so pace idle menus at 60 Hz instead of spinning through empty frames.
+        std::this_thread::sleep_until(lastFrameTime_ + kIdleFrameInterval);
+    }
+    lastFrameTime_ = std::chrono::steady_clock::now();
+    CaptureFrame(packet.items);
+
+    std::lock_guard lock(statsMutex_);
+    lastStats_ = packet.stats;
+}
+
+void Renderer::RequestCapture(std::string filePath, uint32_t frameCount)
+{
+    std::lock_guard lock(captureMutex_);
+    if (capture_) return;
+
+    capture_ = std::make_unique<DrawCapture>();
+    capturePath_ = std::move(filePath);
+    captureFramesLeft_ = std::max(1u, frameCount);
+}
+
+void Renderer::CaptureFrame(const std::vector<DrawItem>& items)
+{
+    std::lock_guard lock(captureMutex_);
+    if (!capture_) return;
+
+    capture_->AddFrame(items);
+    if (--captureFramesLeft_ > 0) return;
+
+    std::shared_ptr<DrawCapture> capture = std::move(capture_);
+    ThreadPool::Shared().Submit([capture, path = std::move(capturePath_)]
+    {
+        if (capture->Save(path))
+            std::cout << "Saved " << capture->GetFrameCount() << " captured frame(s) to " << path << "\n";
+    });
+}
+
+void Renderer::ReplayFrame(std::vector<DrawItem>& items)
+{
+    if (!backend_) return;
+
+    FramePacket packet;
+    packet.items.swap(items);
+    packet.viewport = viewport_;
+    packet.stats.drawItems = static_cast<uint32_t>(packet.items.size());
+    ExecuteFrame(packet);
+    items.swap(packet.items);
+}
+
+void Renderer::SetTextureBatching(bool enabled)
+{
+    textureBatching_ = enabled;
+}
+
+void Renderer::SetRenderScale(float scale)
+{
+    renderScale_ = std::clamp(scale, kMinRenderScale, 1.0f);
+}
+
+void Renderer::SetDynamicResolution(bool enabled, float targetFrameMs)
+{
+    dynamicResolution_ = enabled;
+    targetFrameMs_ = std::max(1.0f, targetFrameMs);
+}
+
+float Renderer::GetRenderScale()
+{
+    return renderScale_;
+}
+
+ITexture* Renderer::AcquireSceneTarget(const Rect& viewport, float scale)
+{
+    const auto width = static_cast<uint32_t>(std::ceil(viewport.Width() * scale));
+    const auto height = static_cast<uint32_t>(std::ceil(viewport.Height() * scale));
+    if (width == 0 || height == 0) return nullptr;
+
+    if (sceneTarget_)
+    {
+        const auto size = sceneTarget_->GetSize();
+        if (static_cast<uint32_t>(size.x) != width || static_cast<uint32_t>(size.y) != height)
+            sceneTarget_.reset();
+    }
+    if (!sceneTarget_)
+        sceneTarget_ = backend_->CreateRenderTarget(width, height);
+    return sceneTarget_.get();
+}
+
+void Renderer::UpdateDynamicResolution(double frameMs)
+{
+    if (!dynamicResolution_) return;
+
+    averageFrameMs_ = averageFrameMs_ > 0.0 ? averageFrameMs_ * 0.9 + frameMs * 0.1 : frameMs;
+    if (scaleCooldown_ > 0)
+    {
+        --scaleCooldown_;
+        return;
+    }
+
+    const double budget = targetFrameMs_;
+    const float scale = renderScale_;
+    float next = scale;
+    if (averageFrameMs_ > budget * 1.05)
+        next = std::max(kMinRenderScale, scale - kRenderScaleStep);
+    else if (averageFrameMs_ < budget * 0.7)
+        next = std::min(1.0f, scale + kRenderScaleStep);
+
+    if (next != scale)
+    {
+        renderScale_ = next;
+        scaleCooldown_ = kScaleCooldownFrames;
+    }
+}
+
+void Renderer::SetPartialRedraw(bool enabled)
+{
+    partialRedraw_ = enabled;
+    forceFullRedraw_ = true;
+}
+
+RenderStats Renderer::GetStats()
+{
+    std::lock_guard lock(statsMutex_);
+    return lastStats_;
 }
 
 void Renderer::ToggleFPS()
@@ -182,84 +827,541 @@ void Renderer::ToggleFPS()
     showFPS_ = !showFPS_;
 }
 
-void Renderer::DrawFPS()
+void Renderer::ToggleStats()
+{
+    showStats_ = !showStats_;
+}
+
+void Renderer::ToggleOverdraw()
+{
+    showOverdraw_ = !showOverdraw_;
+}
+
+void Renderer::SetOverdrawMode(bool enabled)
+{
+    showOverdraw_ = enabled;
+}
+
+void Renderer::DrawOverdraw(const std::vector<DrawItem>& items, const Rect& viewport, RenderStats& stats)
+{
+    const auto width = static_cast<uint32_t>(viewport.Width());
+    const auto height = static_cast<uint32_t>(viewport.Height());
+    if (width == 0 || height == 0) return;
+
+    // Coverage is taken from each item's screen bounds, so rotated sprites count their bounding box.
+    overdrawMap_.Begin(width, height);
+    for (const auto& item : items)
+    {
+        if (item.drawType == DrawType::Rectangle && !item.data.rectangle.filled)
+        {
+            const Rect& r = item.bounds;
+            const float w = item.data.rectangle.strokeWidth;
+            overdrawMap_.Accumulate(Rect(r.Left(), r.Top(), r.Right(), r.Top() + w));
+            overdrawMap_.Accumulate(Rect(r.Left(), r.Bottom() - w, r.Right(), r.Bottom()));
+            overdrawMap_.Accumulate(Rect(r.Left(), r.Top() + w, r.Left() + w, r.Bottom() - w));
+            overdrawMap_.Accumulate(Rect(r.Right() - w, r.Top() + w, r.Right(), r.Bottom() - w));
+            continue;
+        }
+        overdrawMap_.Accumulate(item.bounds);
+    }
+    overdrawMap_.Resolve();
+
+    stats.overdrawFactor = overdrawMap_.GetOverdrawFactor();
+    stats.maxOverdraw = overdrawMap_.GetMaxCount();
+
+    overdrawMap_.BuildHeatmap(overdrawPixels_);
+    if (overdrawTexture_)
+    {
+        const auto size = overdrawTexture_->GetSize();
+        if (static_cast<uint32_t>(size.x) != width || static_cast<uint32_t>(size.y) != height ||
+            !backend_->UpdateTexture(overdrawTexture_.get(), overdrawPixels_, 0, 0))
+            overdrawTexture_.reset();
+    }
+    if (!overdrawTexture_)
+        overdrawTexture_ = backend_->CreateTexture(overdrawPixels_);
+
+    if (overdrawTexture_)
+        backend_->DrawTexture(overdrawTexture_.get(), MatrixHelper::Identity(), 1.0f, Color::White);
+}
+
+void Renderer::DrawFPS(const FramePacket& packet)
 {
-    if (!showFPS_) return;
+    if (!packet.showFPS) return;
 
-    const std::wstring text = std::format(L"{:.2f}", Time::GetFps());
+    const std::wstring text = std::format(L"{:.2f}", packet.fps);
     const Rect layoutRect(8.0f, 4.0f, 300.0f, 40.0f);
 
-    const auto textFormat = backend_->CreateTextFormat(L"Consolas", 20.0f);
-    if (textFormat)
+    if (!overlayFormat_)
+        overlayFormat_ = backend_->CreateTextFormat(L"Consolas", 20.0f);
+    if (overlayFormat_)
     {
-        backend_->DrawTexts(text, layoutRect, textFormat.get(), Color::White, Justification::Left);
+        backend_->DrawTexts(text, layoutRect, overlayFormat_.get(), Color::White, Justification::Left);
     }
 }
 
-void Renderer::FlushDrawQueue()
+void Renderer::DrawStats(const FramePacket& packet)
 {
-    if (drawQueue_.empty()) return;
+    if (!packet.showStats) return;
+
+    static constexpr const wchar_t* kLayerNames[RenderStats::kLayerCount] = {
+        L"Background", L"BackgroundCover", L"Default", L"PlantUnder", L"PlantBase", L"PlantCover", L"PlantTop",
+        L"Zombie", L"Projectile", L"Foreground", L"Fog", L"UI", L"Collectable", L"Debug"
+    };
+
+    const RenderStats& stats = packet.stats;
+    std::wstring text = std::format(
+        L"items {}  culled {}  text {}\n"
+        L"switches {} ({} unbatched)\n"
+        L"sort {:.3f} ms  submit {:.3f} ms\n"
+        L"queue {}  peak {}\n"
+        L"arena {} B  high water {} B\n"
+        L"overdraw {:.2f}x  max {}\n"
+        L"render scale {:.2f}\n",
+        stats.drawItems, stats.culledItems, stats.textDraws,
+        stats.textureSwitches, stats.textureSwitchesUnbatched,
+        stats.sortMs, stats.submitMs,
+        stats.queuedFrames, stats.peakQueuedFrames,
+        stats.arenaBytes, stats.arenaHighWater,
+        stats.overdrawFactor, stats.maxOverdraw,
+        stats.renderScale);
+    for (size_t i = 0; i < stats.layerItems.size(); ++i)
+    {
+        if (stats.layerItems[i] > 0)
+            text += std::format(L"  {:<16}{}\n", kLayerNames[i], stats.layerItems[i]);
+    }
+
+    if (!overlayFormat_)
+        overlayFormat_ = backend_->CreateTextFormat(L"Consolas", 20.0f);
+    if (!overlayFormat_) return;
+
+    const Rect layoutRect(8.0f, packet.showFPS ? 36.0f : 4.0f, 500.0f, 720.0f);
+    backend_->DrawTexts(text, layoutRect, overlayFormat_.get(), Color::White, Justification::Left);
+}
+
+DrawCommandBuffer* Renderer::GetThreadBuffer()
+{
+    if (!t_drawBuffer)
+    {
+        auto buffer = std::make_unique<DrawCommandBuffer>();
+        buffer->items.reserve(1024);
+        t_drawBuffer = buffer.get();
+
+        std::lock_guard lock(threadBuffersMutex_);
+        threadBuffers_.push_back(std::move(buffer));
+    }
+    return t_drawBuffer;
+}
+
+uint32_t Renderer::ReserveSubmitKeys(uint32_t count)
+{
+    return static_cast<uint32_t>(submitSeq_.fetch_add(count));
+}
+
+void Renderer::Submit(DrawItem&& item)
+{
+    item.bounds = ComputeBounds(item);
+
+    if (t_captureTarget)
+    {
+        item.seq = t_captureTarget->size();
+        t_captureTarget->push_back(std::move(item));
+        return;
+    }
+
+    if (!item.bounds.Intersects(viewport_))
+    {
+        culledCount_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    DrawCommandBuffer* buffer = GetThreadBuffer();
+    if (buffer->recording)
+        item.seq = buffer->recordKey | buffer->localSeq++;
+    else
+        item.seq = submitSeq_.fetch_add(1) << 32;
+    buffer->items.push_back(std::move(item));
+}
+
+void Renderer::MergeThreadBuffers()
+{
+    std::lock_guard lock(threadBuffersMutex_);
+
+    size_t total = drawQueue_.size();
+    for (const auto& buffer : threadBuffers_)
+        total += buffer->items.size();
+    drawQueue_.reserve(total);
 
-    std::ranges::sort(drawQueue_, [](const DrawItem& a, const DrawItem& b)
+    for (const auto& buffer : threadBuffers_)
+    {
+        std::ranges::move(buffer->items, std::back_inserter(drawQueue_));
+        buffer->items.clear();
+    }
+}
+
+void Renderer::SortDrawQueue(std::vector<DrawItem>& items, RenderStats& stats)
+{
+    if (items.empty()) return;
+
+    const auto sortStart = std::chrono::steady_clock::now();
+    std::ranges::sort(items, [](const DrawItem& a, const DrawItem& b)
     {
         if (a.z != b.z) return a.z < b.z;
         return a.seq < b.seq;
     });
+
+    stats.textureSwitchesUnbatched = CountTextureSwitches(items);
+    if (textureBatching_.load(std::memory_order_relaxed))
+    {
+        BatchByTexture(items);
+        stats.textureSwitches = CountTextureSwitches(items);
+    }
+    else
+    {
+        stats.textureSwitches = stats.textureSwitchesUnbatched;
+    }
+
+    stats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sortStart).count();
+}
+
+void Renderer::FlushDrawQueue(const std::vector<DrawItem>& items, RenderStats& stats, bool dirtyOnly,
+                              const Affine2D* parent)
+{
+    if (items.empty()) return;
+
+    const auto submitStart = std::chrono::steady_clock::now();
     backend_->Lock();
 
-    for (const auto& di : drawQueue_)
+    for (const auto& di : items)
+    {
+        if (dirtyOnly && !TouchesDirtyTile(di.bounds)) continue;
+
+        const int layer = di.z - static_cast<int>(RenderLayer::Background);
+        ++stats.layerItems[std::min<size_t>(std::max(layer, 0), stats.layerItems.size() - 1)];
+        if (di.drawType == DrawType::Text)
+            ++stats.textDraws;
+
+        DrawItemImmediate(di, parent);
+    }
+
+    backend_->Unlock();
+
+    stats.submitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submitStart).count();
+}
+
+uint32_t Renderer::UpdateDirtyTiles(const std::vector<DrawItem>& items, const Rect& viewport)
+{
+    const auto tilesX = static_cast<uint32_t>(std::ceil(viewport.Width() / static_cast<float>(kDirtyTileSize)));
+    const auto tilesY = static_cast<uint32_t>(std::ceil(viewport.Height() / static_cast<float>(kDirtyTileSize)));
+    const size_t tileCount = static_cast<size_t>(tilesX) * tilesY;
+    const bool hasHistory = previousTileHashes_.size() == tileCount && tilesX == dirtyTilesX_;
+
+    dirtyTilesX_ = tilesX;
+    dirtyTilesY_ = tilesY;
+    tileHashes_.assign(tileCount, kTileHashSeed);
+
+    // Items are already in draw order, so folding them in sequence also catches pure reordering.
+    for (const auto& item : items)
+    {
+        const uint64_t itemHash = HashDrawItem(item);
+        const TileSpan span = ToTileSpan(item.bounds, tilesX, tilesY);
+        for (uint32_t ty = span.y0; ty < span.y1; ++ty)
+        {
+            for (uint32_t tx = span.x0; tx < span.x1; ++tx)
+                HashCombine(tileHashes_[ty * tilesX + tx], itemHash);
+        }
+    }
+
+    uint32_t dirtyCount = 0;
+    dirtyTiles_.assign(tileCount, 0);
+    for (size_t t = 0; t < tileCount; ++t)
     {
-        switch (di.drawType)
+        if (!hasHistory || tileHashes_[t] != previousTileHashes_[t])
         {
-        case DrawType::Image:
-            if (di.data.image.texture)
+            dirtyTiles_[t] = 1;
+            ++dirtyCount;
+        }
+    }
+    tileHashes_.swap(previousTileHashes_);
+
+    dirtyRects_.clear();
+    for (uint32_t ty = 0; ty < tilesY; ++ty)
+    {
+        for (uint32_t tx = 0; tx < tilesX;)
+        {
+            if (!dirtyTiles_[ty * tilesX + tx])
             {
-                backend_->DrawTexture(
-                    di.data.image.texture.get(),
-                    di.data.image.transform,
-                    di.opacity,
-                    di.data.image.tint);
+                ++tx;
+                continue;
             }
+
+            const uint32_t runStart = tx;
+            while (tx < tilesX && dirtyTiles_[ty * tilesX + tx])
+                ++tx;
+            dirtyRects_.emplace_back(static_cast<float>(runStart * kDirtyTileSize),
+                                     static_cast<float>(ty * kDirtyTileSize),
+                                     static_cast<float>(tx * kDirtyTileSize),
+                                     static_cast<float>((ty + 1) * kDirtyTileSize));
+        }
+    }
+
+    return dirtyCount;
+}
+
+bool Renderer::TouchesDirtyTile(const Rect& bounds)
+{
+    const TileSpan span = ToTileSpan(bounds, dirtyTilesX_, dirtyTilesY_);
+    for (uint32_t ty = span.y0; ty < span.y1; ++ty)
+    {
+        for (uint32_t tx = span.x0; tx < span.x1; ++tx)
+        {
+            if (dirtyTiles_[ty * dirtyTilesX_ + tx]) return true;
+        }
+    }
+    return false;
+}
+
+uint64_t Renderer::HashDrawItem(const DrawItem& item)
+{
+    uint64_t hash = kTileHashSeed;
+    HashCombine(hash, static_cast<uint64_t>(item.drawType));
+    HashCombine(hash, static_cast<uint64_t>(item.z));
+    HashFloat(hash, item.opacity);
+    HashRect(hash, item.bounds);
+
+    switch (item.drawType)
+    {
+    case DrawType::Image:
+        HashCombine(hash, reinterpret_cast<uintptr_t>(item.data.image.texture.get()));
+        HashAffine(hash, item.data.image.transform);
+        HashColor(hash, item.data.image.tint);
+        break;
+    case DrawType::ImageAtlas:
+        {
+            const auto& region = item.data.imageAtlas.region;
+            HashCombine(hash, reinterpret_cast<uintptr_t>(item.data.imageAtlas.texture.get()));
+            HashAffine(hash, item.data.imageAtlas.transform);
+            HashColor(hash, item.data.imageAtlas.tint);
+            HashCombine(hash, region.x);
+            HashCombine(hash, region.y);
+            HashCombine(hash, region.width);
+            HashCombine(hash, region.height);
             break;
-        case DrawType::ImageAtlas:
-            if (di.data.imageAtlas.texture)
+        }
+    case DrawType::Text:
+        HashCombine(hash, std::hash<std::wstring_view>{}(item.data.text.text));
+        HashCombine(hash, reinterpret_cast<uintptr_t>(item.data.text.textFormat.get()));
+        HashRect(hash, item.data.text.rect);
+        HashColor(hash, item.data.text.color);
+        HashCombine(hash, static_cast<uint64_t>(item.data.text.justification));
+        break;
+    case DrawType::Rectangle:
+        HashRect(hash, item.data.rectangle.rect);
+        HashColor(hash, item.data.rectangle.color);
+        HashFloat(hash, item.data.rectangle.strokeWidth);
+        HashCombine(hash, item.data.rectangle.filled);
+        break;
+    case DrawType::CachedLayer:
+        HashCombine(hash, reinterpret_cast<uintptr_t>(item.data.cachedLayer.cache.get()));
+        HashCombine(hash, item.data.cachedLayer.version);
+        HashRect(hash, item.data.cachedLayer.bounds);
+        break;
+    }
+    return hash;
+}
+
+const void* Renderer::GetBatchKey(const DrawItem& item)
+{
+    switch (item.drawType)
+    {
+    case DrawType::Image:
+        return item.data.image.texture.get();
+    case DrawType::ImageAtlas:
+        return item.data.imageAtlas.texture.get();
+    case DrawType::Text:
+        return item.data.text.textFormat.get();
+    case DrawType::CachedLayer:
+        return item.data.cachedLayer.cache.get();
+    case DrawType::Rectangle:
+        break;
+    }
+    return nullptr;
+}
+
+uint32_t Renderer::CountTextureSwitches(const std::vector<DrawItem>& items)
+{
+    uint32_t switches = 0;
+    const void* current = nullptr;
+    for (const auto& item : items)
+    {
+        const void* key = GetBatchKey(item);
+        if (!key || key == current) continue;
+        if (current) ++switches;
+        current = key;
+    }
+    return switches;
+}
+
+void Renderer::BatchByTexture(std::vector<DrawItem>& items)
+{
+    struct Batch
+    {
+        const void* key;
+        Rect bounds;
+        uint32_t head;
+        uint32_t tail;
+    };
+
+    // Items arrive sorted by (z, seq). Each one joins the nearest earlier batch of the same texture
+    // within its z layer, provided it overlaps none of the batches it would jump ahead of.
+    std::vector<Batch> batches;
+    std::vector<uint32_t> next(items.size(), UINT32_MAX);
+    size_t layerStart = 0;
+
+    for (uint32_t i = 0; i < items.size(); ++i)
+    {
+        const DrawItem& item = items[i];
+        if (i > 0 && item.z != items[i - 1].z)
+            layerStart = batches.size();
+
+        const void* key = GetBatchKey(item);
+        const size_t stop = std::max(layerStart, batches.size() > kBatchLookback
+                                                     ? batches.size() - kBatchLookback
+                                                     : 0);
+        bool placed = false;
+        for (size_t b = batches.size(); key && b-- > stop;)
+        {
+            Batch& batch = batches[b];
+            if (batch.key == key)
             {
-                const auto& region = di.data.imageAtlas.region;
-                const Rect sourceRect(region.x, region.y,
-                                      region.x + region.width,
-                                      region.y + region.height);
-                backend_->DrawTextureRect(
-                    di.data.imageAtlas.texture.get(),
-                    di.data.imageAtlas.transform,
-                    sourceRect,
-                    di.opacity,
-                    di.data.imageAtlas.tint);
+                next[batch.tail] = i;
+                batch.tail = i;
+                batch.bounds = Union(batch.bounds, item.bounds);
+                placed = true;
+                break;
             }
-            break;
-        case DrawType::Text:
-            if (di.data.text.textFormat)
+            if (batch.bounds.Intersects(item.bounds)) break;
+        }
+
+        if (!placed)
+            batches.push_back({key, item.bounds, i, i});
+    }
+
+    if (batches.size() == items.size()) return;
+
+    batchScratch_.clear();
+    batchScratch_.reserve(items.size());
+    for (const auto& batch : batches)
+    {
+        for (uint32_t i = batch.head; i != UINT32_MAX; i = next[i])
+            batchScratch_.push_back(std::move(items[i]));
+    }
+    items.swap(batchScratch_);
+    batchScratch_.clear();
+}
+
+void Renderer::DrawItemImmediate(const DrawItem& item, const Affine2D* parent)
+{
+    switch (item.drawType)
+    {
+    case DrawType::Image:
+        if (const auto& texture = item.data.image.texture)
+        {
+            const Affine2D transform = parent ? *parent * item.data.image.transform : item.data.image.transform;
+            // Enqueueing redirects atlas-only images to their page, but replayed captures can still name them.
+            if (dynamic_cast<const AtlasTexture*>(texture.get()))
             {
-                backend_->DrawTexts(
-                    di.data.text.text,
-                    di.data.text.rect,
-                    di.data.text.textFormat.get(),
-                    di.data.text.color,
-                    di.data.text.justification);
+                const auto& entry = texture->GetAtlasEntry();
+                backend_->DrawTextureRect(entry->page.get(), ToPackedSpace(transform, entry->region),
+                                          PackedRect(entry->region), item.opacity, item.data.image.tint);
             }
-            break;
-        case DrawType::Rectangle:
-            backend_->DrawRectangle(
-                di.data.rectangle.rect,
-                di.data.rectangle.color,
-                di.data.rectangle.strokeWidth,
-                di.data.rectangle.filled);
-            break;
+            else
+            {
+                backend_->DrawTexture(texture.get(), transform, item.opacity, item.data.image.tint);
+            }
+        }
+        break;
+    case DrawType::ImageAtlas:
+        if (item.data.imageAtlas.texture)
+        {
+            backend_->DrawTextureRect(
+                item.data.imageAtlas.texture.get(),
+                parent ? *parent * item.data.imageAtlas.transform : item.data.imageAtlas.transform,
+                PackedRect(item.data.imageAtlas.region),
+                item.opacity,
+                item.data.imageAtlas.tint);
         }
+        break;
+    case DrawType::Text:
+        if (item.data.text.textFormat)
+        {
+            if (parent) backend_->SetTransform(*parent);
+            backend_->DrawTexts(
+                item.data.text.text,
+                item.data.text.rect,
+                item.data.text.textFormat.get(),
+                item.data.text.color,
+                item.data.text.justification);
+            if (parent) backend_->SetTransform(MatrixHelper::Identity());
+        }
+        break;
+    case DrawType::Rectangle:
+        if (parent) backend_->SetTransform(*parent);
+        backend_->DrawRectangle(
+            item.data.rectangle.rect,
+            item.data.rectangle.color,
+            item.data.rectangle.strokeWidth,
+            item.data.rectangle.filled);
+        if (parent) backend_->SetTransform(MatrixHelper::Identity());
+        break;
+    case DrawType::CachedLayer:
+        DrawCachedLayer(item, parent);
+        break;
     }
+}
 
-    backend_->Unlock();
+void Renderer::DrawCachedLayer(const DrawItem& item, const Affine2D* parent)
+{
+    const auto& layer = item.data.cachedLayer;
+    if (!layer.cache || !layer.items || layer.items->empty()) return;
 
-    drawQueue_.clear();
+    const auto width = static_cast<uint32_t>(std::ceil(layer.bounds.Width()));
+    const auto height = static_cast<uint32_t>(std::ceil(layer.bounds.Height()));
+    if (width == 0 || height == 0) return;
+
+    RenderLayerCache& cache = *layer.cache;
+    const Affine2D translation = MatrixHelper::Translation(layer.bounds.min);
+    const Affine2D placement = parent ? *parent * translation : translation;
+
+    if (cache.target)
+    {
+        const auto size = cache.target->GetSize();
+        if (static_cast<uint32_t>(size.x) != width || static_cast<uint32_t>(size.y) != height)
+            cache.target.reset();
+    }
+
+    if (!cache.target || cache.builtVersion != layer.version)
+    {
+        if (!cache.target)
+            cache.target = backend_->CreateRenderTarget(width, height);
+
+        if (!cache.target)
+        {
+            for (const auto& child : *layer.items)
+                DrawItemImmediate(child, parent);
+            return;
+        }
+
+        const Affine2D offset = MatrixHelper::Translation(-layer.bounds.min);
+        backend_->SetRenderTarget(cache.target.get());
+        backend_->Clear(Color::Transparent);
+        for (const auto& child : *layer.items)
+            DrawItemImmediate(child, &offset);
+        backend_->SetRenderTarget(frameTarget_);
+
+        cache.builtVersion = layer.version;
+    }
+
+    backend_->DrawTexture(cache.target.get(), placement, item.opacity, Color::White);
 }
 
 void Renderer::EnqueueImage(const std::shared_ptr<ITexture>& texture, const Transform& transform,
@@ -269,20 +1371,22 @@ void Renderer::EnqueueImage(const std::shared_ptr<ITexture>& texture, const Tran
 
     const auto size = texture->GetSize();
 
-    const glm::mat3 mat1 = MatrixHelper::Translation(-size / 2.0f);
-    const glm::mat3 mat2 = MatrixHelper::Scale(transform.scale);
-    const glm::mat3 mat3 = MatrixHelper::Rotation(transform.rotation);
-    const glm::mat3 mat4 = MatrixHelper::Translation(transform.position + size / 2.0f);
+    Affine2D mat = MatrixHelper::Compose(transform.position, transform.scale, transform.rotation, size / 2.0f);
+    const auto source = SelectMip(texture, mat);
 
-    const glm::mat3 mat = mat4 * mat3 * mat2 * mat1;
+    // Full-size draws of textures that also live in the global atlas sample the shared page instead.
+    if (const auto& entry = source->GetAtlasEntry())
+    {
+        SubmitAtlasRegion(entry->page, mat, entry->region, z, opacity, Color::White);
+        return;
+    }
 
     DrawItem di;
     di.opacity = opacity;
     di.z = z;
-    di.seq = submitSeq_++;
     di.drawType = DrawType::Image;
-    new(&di.data.image) DrawItem::ImageData(texture, mat);
-    drawQueue_.push_back(std::move(di));
+    new(&di.data.image) DrawItem::ImageData(source, mat);
+    Submit(std::move(di));
 }
 
 void Renderer::EnqueueReanim(const std::shared_ptr<ITexture>& texture, const ReanimatorTransform& transform, int z,
@@ -298,19 +1402,50 @@ void Renderer::EnqueueReanim(const std::shared_ptr<ITexture>& texture, const Rea
     const float c = -std::sin(ky) * transform.scale.y;
     const float d = std::cos(ky) * transform.scale.y;
 
-    const glm::mat3 mat = MatrixHelper::CreateMatrix(
+    Affine2D mat = MatrixHelper::CreateMatrix(
         a, b,
         c, d,
         transform.translation.x, transform.translation.y);
 
+    const auto source = SelectMip(texture, mat);
+    if (const auto& entry = source->GetAtlasEntry())
+    {
+        SubmitAtlasRegion(entry->page, mat, entry->region, z, opacity, tint);
+        return;
+    }
+
     DrawItem di;
     di.opacity = opacity;
     di.z = z;
-    di.seq = submitSeq_++;
     di.drawType = DrawType::Image;
-    new(&di.data.image) DrawItem::ImageData(texture, mat);
+    new(&di.data.image) DrawItem::ImageData(source, mat);
     di.data.image.tint = tint;
-    drawQueue_.push_back(std::move(di));
+    Submit(std::move(di));
+}
+
+std::shared_ptr<ITexture> Renderer::SelectMip(const std::shared_ptr<ITexture>& texture, Affine2D& mat)
+{
+    // Largest texel-to-pixel stretch of either axis, including the internal resolution scale. Static layers are
+    // cached at full resolution and outlive scale changes, so their recordings ignore it.
+    const float resolution = t_captureTarget ? 1.0f : renderScale_.load(std::memory_order_relaxed);
+    const float scale = std::max(std::hypot(mat.m11, mat.m12), std::hypot(mat.m21, mat.m22)) * resolution;
+
+    // Smallest level that still has at least one texel per screen pixel.
+    int level = 0;
+    if (scale <= 0.25f) level = 2;
+    else if (scale <= 0.5f) level = 1;
+
+    for (; level > 0; --level)
+    {
+        const auto& mip = texture->GetMip(level);
+        if (!mip) continue;
+
+        const auto size = texture->GetSize();
+        const auto mipSize = mip->GetSize();
+        mat = mat * MatrixHelper::Scale({size.x / mipSize.x, size.y / mipSize.y});
+        return mip;
+    }
+    return texture;
 }
 
 void Renderer::EnqueueReanimAtlas(const std::shared_ptr<ITexture>& atlasTexture,
@@ -328,19 +1463,43 @@ void Renderer::EnqueueReanimAtlas(const std::shared_ptr<ITexture>& atlasTexture,
     const float c = -std::sin(ky) * transform.scale.y;
     const float d = std::cos(ky) * transform.scale.y;
 
-    const glm::mat3 mat = MatrixHelper::CreateMatrix(
+    Affine2D mat = MatrixHelper::CreateMatrix(
         a, b,
         c, d,
         transform.translation.x, transform.translation.y);
 
+    SubmitAtlasRegion(atlasTexture, mat, region, z, opacity, tint);
+}
+
+void Renderer::SubmitAtlasRegion(const std::shared_ptr<ITexture>& atlasTexture, const Affine2D& mat,
+                                 const AtlasRegion& region, int z, float opacity, const Color& tint)
+{
     DrawItem di;
     di.opacity = opacity;
     di.z = z;
-    di.seq = submitSeq_++;
     di.drawType = DrawType::ImageAtlas;
-    new(&di.data.imageAtlas) DrawItem::ImageAtlasData(atlasTexture, mat, region);
+    new(&di.data.imageAtlas) DrawItem::ImageAtlasData(atlasTexture, ToPackedSpace(mat, region), region);
     di.data.imageAtlas.tint = tint;
-    drawQueue_.push_back(std::move(di));
+    Submit(std::move(di));
+}
+
+std::shared_ptr<ITextFormat> Renderer::GetTextFormat(std::wstring_view fontFamily, float fontSize)
+{
+    auto& cache = t_textFormats;
+    if (const uint32_t generation = backendGeneration_.load(std::memory_order_relaxed); cache.generation != generation)
+    {
+        cache.formats.clear();
+        cache.generation = generation;
+    }
+
+    if (const auto it = cache.formats.find(TextFormatView{fontFamily, fontSize}); it != cache.formats.end())
+        return it->second;
+
+    std::wstring family(fontFamily);
+    auto format = backend_->CreateTextFormat(family, fontSize);
+    if (format)
+        cache.formats.emplace(TextFormatKey{std::move(family), fontSize}, format);
+    return format;
 }
 
 void Renderer::EnqueueTextW(const std::wstring& text,
@@ -353,15 +1512,20 @@ void Renderer::EnqueueTextW(const std::wstring& text,
 {
     if (text.empty() || !backend_) return;
 
-    const auto textFormat = backend_->CreateTextFormat(fontFamily, fontSize);
+    const auto textFormat = GetTextFormat(fontFamily, fontSize);
     if (!textFormat) return;
 
+    // Static layer captures keep their items past this frame, so they cannot borrow arena memory.
+    const bool persistent = t_captureTarget || !frameArena_;
+
     DrawItem di;
     di.z = z;
-    di.seq = submitSeq_++;
     di.drawType = DrawType::Text;
-    new(&di.data.text) DrawItem::TextData(text, textFormat, layoutRect, color, justification);
-    drawQueue_.push_back(std::move(di));
+    new(&di.data.text) DrawItem::TextData(persistent ? std::wstring_view(text) : frameArena_->CopyString(text),
+                                          textFormat, layoutRect, color, justification);
+    if (persistent)
+        di.data.text.MakeOwned();
+    Submit(std::move(di));
 }
 
 void Renderer::EnqueueRectangle(const Rect& rect,
@@ -372,10 +1536,73 @@ void Renderer::EnqueueRectangle(const Rect& rect,
 {
     DrawItem di;
     di.z = z;
-    di.seq = submitSeq_++;
     di.drawType = DrawType::Rectangle;
     new(&di.data.rectangle) DrawItem::RectangleData(rect, color, strokeWidth, filled);
-    drawQueue_.push_back(std::move(di));
+    Submit(std::move(di));
+}
+
+void Renderer::EnqueueCachedLayer(const std::shared_ptr<RenderLayerCache>& cache,
+                                  const std::shared_ptr<const std::vector<DrawItem>>& items,
+                                  const Rect& bounds,
+                                  uint64_t version,
+                                  int z,
+                                  float opacity)
+{
+    if (!cache || !items || items->empty()) return;
+
+    DrawItem di;
+    di.opacity = opacity;
+    di.z = z;
+    di.drawType = DrawType::CachedLayer;
+    new(&di.data.cachedLayer) DrawItem::CachedLayerData(cache, items, bounds, version);
+    Submit(std::move(di));
+}
+
+Rect Renderer::ComputeBounds(const DrawItem& item)
+{
+    auto transformBounds = [](const Affine2D& m, float w, float h)
+    {
+        const float xs[4] = {m.dx, w * m.m11 + m.dx, h * m.m21 + m.dx, w * m.m11 + h * m.m21 + m.dx};
+        const float ys[4] = {m.dy, w * m.m12 + m.dy, h * m.m22 + m.dy, w * m.m12 + h * m.m22 + m.dy};
+        return Rect(std::min({xs[0], xs[1], xs[2], xs[3]}), std::min({ys[0], ys[1], ys[2], ys[3]}),
+                    std::max({xs[0], xs[1], xs[2], xs[3]}), std::max({ys[0], ys[1], ys[2], ys[3]}));
+    };
+
+    switch (item.drawType)
+    {
+    case DrawType::Image:
+        if (item.data.image.texture)
+        {
+            const auto size = item.data.image.texture->GetSize();
+            return transformBounds(item.data.image.transform, size.x, size.y);
+        }
+        break;
+    case DrawType::ImageAtlas:
+        return transformBounds(item.data.imageAtlas.transform,
+                               static_cast<float>(item.data.imageAtlas.region.PackedWidth()),
+                               static_cast<float>(item.data.imageAtlas.region.PackedHeight()));
+    case DrawType::Text:
+        return item.data.text.rect;
+    case DrawType::Rectangle:
+        {
+            const float h = item.data.rectangle.filled ? 0.0f : item.data.rectangle.strokeWidth * 0.5f;
+            const Rect& r = item.data.rectangle.rect;
+            return Rect(r.Left() - h, r.Top() - h, r.Right() + h, r.Bottom() + h);
+        }
+    case DrawType::CachedLayer:
+        return item.data.cachedLayer.bounds;
+    }
+    return {};
+}
+
+void Renderer::BeginCapture(std::vector<DrawItem>* target)
+{
+    t_captureTarget = target;
+}
+
+void Renderer::EndCapture()
+{
+    t_captureTarget = nullptr;
 }
 
 IRenderBackend* Renderer::GetRenderBackend()
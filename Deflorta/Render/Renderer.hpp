@@ -2,20 +2,48 @@
 
 #include "IRenderBackend.hpp"
 #include "AtlasBuilder.hpp"
+#include "FrameArena.hpp"
+#include "Layer.hpp"
+#include "OverdrawMap.hpp"
 #include "../Base/Transform.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <string>
+#include <string_view>
 
 struct ReanimatorTransform;
+class DrawCapture;
+
+enum class RenderBackendType : std::uint8_t
+{
+    Direct2D,
+    Software
+};
 
 enum class DrawType : std::uint8_t
 {
     Image,
     ImageAtlas,
     Text,
-    Rectangle
+    Rectangle,
+    CachedLayer
+};
+
+struct DrawItem;
+
+struct RenderLayerCache
+{
+    std::shared_ptr<ITexture> target;
+    uint64_t builtVersion = 0;
 };
 
 struct DrawItem
@@ -23,11 +51,11 @@ struct DrawItem
     struct ImageData
     {
         std::shared_ptr<ITexture> texture;
-        glm::mat3 transform{};
+        Affine2D transform{};
         Color tint = Color::White;
         ImageData() = default;
 
-        ImageData(std::shared_ptr<ITexture> tex, const glm::mat3& m)
+        ImageData(std::shared_ptr<ITexture> tex, const Affine2D& m)
             : texture(std::move(tex)), transform(m)
         {
         }
@@ -36,12 +64,12 @@ struct DrawItem
     struct ImageAtlasData
     {
         std::shared_ptr<ITexture> texture;
-        glm::mat3 transform{};
+        Affine2D transform{};
         AtlasRegion region;
         Color tint = Color::White;
         ImageAtlasData() = default;
 
-        ImageAtlasData(std::shared_ptr<ITexture> tex, const glm::mat3& m, const AtlasRegion& r)
+        ImageAtlasData(std::shared_ptr<ITexture> tex, const Affine2D& m, const AtlasRegion& r)
             : texture(std::move(tex)), transform(m), region(r)
         {
         }
@@ -49,18 +77,27 @@ struct DrawItem
 
     struct TextData
     {
-        std::wstring text;
+        // Points into the frame arena; text that must outlive the frame is copied into owned by MakeOwned.
+        std::wstring_view text;
+        std::shared_ptr<const std::wstring> owned;
         std::shared_ptr<ITextFormat> textFormat;
         Rect rect{};
         Color color{};
         Justification justification = Justification::Left;
         TextData() = default;
 
-        TextData(std::wstring tx, std::shared_ptr<ITextFormat> fmt, const Rect& r, const Color& c,
+        TextData(std::wstring_view tx, std::shared_ptr<ITextFormat> fmt, const Rect& r, const Color& c,
                  Justification j = Justification::Left)
-            : text(std::move(tx)), textFormat(std::move(fmt)), rect(r), color(c), justification(j)
+            : text(tx), textFormat(std::move(fmt)), rect(r), color(c), justification(j)
         {
         }
+
+        void MakeOwned()
+        {
+            if (owned && owned->data() == text.data()) return;
+            owned = std::make_shared<const std::wstring>(text);
+            text = *owned;
+        }
     };
 
     struct RectangleData
@@ -77,12 +114,28 @@ struct DrawItem
         }
     };
 
+    struct CachedLayerData
+    {
+        std::shared_ptr<RenderLayerCache> cache;
+        std::shared_ptr<const std::vector<DrawItem>> items;
+        Rect bounds{};
+        uint64_t version = 0;
+        CachedLayerData() = default;
+
+        CachedLayerData(std::shared_ptr<RenderLayerCache> c, std::shared_ptr<const std::vector<DrawItem>> i,
+                        const Rect& b, uint64_t v)
+            : cache(std::move(c)), items(std::move(i)), bounds(b), version(v)
+        {
+        }
+    };
+
     union ItemData
     {
         ImageData image;
         ImageAtlasData imageAtlas;
         TextData text;
         RectangleData rectangle;
+        CachedLayerData cachedLayer;
 
         ItemData() { new(&image) ImageData(); }
 
@@ -93,7 +146,8 @@ struct DrawItem
 
     float opacity = 1.0f;
     int z = 0;
-    size_t seq = 0;
+    uint64_t seq = 0;
+    Rect bounds{};
     DrawType drawType = DrawType::Image;
     ItemData data;
 
@@ -109,15 +163,82 @@ private:
     void DestroyActive();
 };
 
+struct DrawCommandBuffer
+{
+    std::vector<DrawItem> items;
+    uint64_t recordKey = 0;
+    uint32_t localSeq = 0;
+    bool recording = false;
+};
+
+struct RenderStats
+{
+    static constexpr size_t kLayerCount = static_cast<size_t>(RenderLayer::Count) -
+        static_cast<size_t>(RenderLayer::Background);
+
+    uint32_t drawItems = 0;
+    uint32_t culledItems = 0;
+    uint32_t textureSwitches = 0;
+    uint32_t textureSwitchesUnbatched = 0;
+    uint32_t textDraws = 0;
+    uint32_t queuedFrames = 0;
+    uint32_t peakQueuedFrames = 0;
+    uint32_t dirtyTiles = 0;
+    bool skippedFrame = false;
+    float renderScale = 1.0f;
+    float overdrawFactor = 0.0f;
+    uint32_t maxOverdraw = 0;
+    size_t arenaBytes = 0;
+    size_t arenaHighWater = 0;
+    double sortMs = 0.0;
+    double submitMs = 0.0;
+    // Items per RenderLayer, indexed from RenderLayer::Background; out-of-range z values land in the end slots.
+    std::array<uint32_t, kLayerCount> layerItems{};
+};
+
+struct FramePacket
+{
+    std::vector<DrawItem> items;
+    std::unique_ptr<FrameArena> arena;
+    RenderStats stats;
+    bool showFPS = false;
+    bool showStats = false;
+    bool showOverdraw = false;
+    bool partialRedraw = false;
+    float renderScale = 1.0f;
+    Rect viewport;
+    double fps = 0.0;
+};
+
+class DrawRecordScope
+{
+public:
+    explicit DrawRecordScope(uint32_t key);
+    ~DrawRecordScope();
+
+    DrawRecordScope(const DrawRecordScope&) = delete;
+    DrawRecordScope& operator=(const DrawRecordScope&) = delete;
+
+private:
+    DrawCommandBuffer* buffer_;
+    uint64_t previousKey_;
+    uint32_t previousSeq_;
+    bool previousRecording_;
+};
+
 class Renderer final
 {
 public:
-    static bool Initialize(void* windowHandle);
+    static bool Initialize(void* windowHandle, RenderBackendType backendType = RenderBackendType::Direct2D,
+                           bool useRenderThread = true);
     static void Resize(uint32_t width, uint32_t height);
     static void BeginFrame();
     static void Render();
     static void Cleanup();
     static void ToggleFPS();
+    static void ToggleStats();
+    static void ToggleOverdraw();
+    static void SetOverdrawMode(bool enabled);
 
     static void EnqueueImage(const std::shared_ptr<ITexture>& texture, const Transform& transform, float opacity,
                              int z);
@@ -141,15 +262,132 @@ public:
                                  float strokeWidth,
                                  bool filled,
                                  int z);
+    static void EnqueueCachedLayer(const std::shared_ptr<RenderLayerCache>& cache,
+                                   const std::shared_ptr<const std::vector<DrawItem>>& items,
+                                   const Rect& bounds,
+                                   uint64_t version,
+                                   int z,
+                                   float opacity);
+
+    static Rect ComputeBounds(const DrawItem& item);
+
+    static uint32_t ReserveSubmitKeys(uint32_t count);
+    static void SetMaxQueuedFrames(uint32_t count);
+    static void SetTextureBatching(bool enabled);
+    static void SetPartialRedraw(bool enabled);
+    static void SetRenderScale(float scale);
+    static void SetDynamicResolution(bool enabled, float targetFrameMs = 1000.0f / 60.0f);
+    static float GetRenderScale();
+    static RenderStats GetStats();
+    static void RequestCapture(std::string filePath, uint32_t frameCount = 1);
+    static void ReplayFrame(std::vector<DrawItem>& items);
+    static bool IsRenderThreadRunning();
+    static void RunOnBackendThread(std::vector<std::function<void()>> tasks);
+    static void PumpBackendTasks();
 
     static IRenderBackend* GetRenderBackend();
 
 private:
-    static void DrawFPS();
-    static void FlushDrawQueue();
+    friend class DrawRecordScope;
+    friend class StaticLayer;
+
+    static void DrawFPS(const FramePacket& packet);
+    static void DrawStats(const FramePacket& packet);
+    static void DrawOverdraw(const std::vector<DrawItem>& items, const Rect& viewport, RenderStats& stats);
+    static void SortDrawQueue(std::vector<DrawItem>& items, RenderStats& stats);
+    static void FlushDrawQueue(const std::vector<DrawItem>& items, RenderStats& stats, bool dirtyOnly,
+                               const Affine2D* parent);
+    static ITexture* AcquireSceneTarget(const Rect& viewport, float scale);
+    static void UpdateDynamicResolution(double frameMs);
+    static uint32_t UpdateDirtyTiles(const std::vector<DrawItem>& items, const Rect& viewport);
+    static bool TouchesDirtyTile(const Rect& bounds);
+    static uint64_t HashDrawItem(const DrawItem& item);
+    static void BatchByTexture(std::vector<DrawItem>& items);
+    static std::shared_ptr<ITextFormat> GetTextFormat(std::wstring_view fontFamily, float fontSize);
+    static std::shared_ptr<ITexture> SelectMip(const std::shared_ptr<ITexture>& texture, Affine2D& mat);
+    static void SubmitAtlasRegion(const std::shared_ptr<ITexture>& atlasTexture, const Affine2D& mat,
+                                  const AtlasRegion& region, int z, float opacity, const Color& tint);
+    static uint32_t CountTextureSwitches(const std::vector<DrawItem>& items);
+    static const void* GetBatchKey(const DrawItem& item);
+    static void DrawItemImmediate(const DrawItem& item, const Affine2D* parent = nullptr);
+    static void DrawCachedLayer(const DrawItem& item, const Affine2D* parent);
+    static void BeginCapture(std::vector<DrawItem>* target);
+    static void EndCapture();
+    static void ExecuteFrame(FramePacket& packet);
+    static void CaptureFrame(const std::vector<DrawItem>& items);
+    static void RenderThreadLoop();
+    static void StartRenderThread();
+    static void StopRenderThread();
+    static void RecyclePacket(FramePacket& packet);
+    static void RunPendingUploads(bool drainAll);
+    static void MergeThreadBuffers();
+    static void Submit(DrawItem&& item);
+    static DrawCommandBuffer* GetThreadBuffer();
 
     static std::unique_ptr<IRenderBackend> backend_;
     static bool showFPS_;
+    static bool showStats_;
+    static std::atomic<bool> showOverdraw_;
+    static OverdrawMap overdrawMap_;
+    static PixelData overdrawPixels_;
+    static std::shared_ptr<ITexture> overdrawTexture_;
+    static std::shared_ptr<ITextFormat> overlayFormat_;
     static std::vector<DrawItem> drawQueue_;
-    static size_t submitSeq_;
+    static std::atomic<uint64_t> submitSeq_;
+    static std::atomic<uint32_t> culledCount_;
+    static Rect viewport_;
+    static std::atomic<bool> textureBatching_;
+    static std::vector<DrawItem> batchScratch_;
+    static std::atomic<bool> partialRedraw_;
+    static std::atomic<bool> forceFullRedraw_;
+    static std::vector<uint64_t> tileHashes_;
+    static std::vector<uint64_t> previousTileHashes_;
+    static std::vector<uint8_t> dirtyTiles_;
+    static std::vector<Rect> dirtyRects_;
+    static uint32_t dirtyTilesX_;
+    static uint32_t dirtyTilesY_;
+    static std::chrono::steady_clock::time_point lastFrameTime_;
+
+    static std::atomic<float> renderScale_;
+    static std::atomic<bool> dynamicResolution_;
+    static std::atomic<float> targetFrameMs_;
+    // Bumped whenever the backend is created or destroyed, so per-thread text format caches drop stale formats.
+    static std::atomic<uint32_t> backendGeneration_;
+    static double averageFrameMs_;
+    static uint32_t scaleCooldown_;
+    static std::shared_ptr<ITexture> sceneTarget_;
+    static ITexture* frameTarget_;
+    static RenderStats lastStats_;
+    static std::mutex statsMutex_;
+
+    static std::unique_ptr<DrawCapture> capture_;
+    static std::string capturePath_;
+    static uint32_t captureFramesLeft_;
+    static std::mutex captureMutex_;
+    static std::vector<std::unique_ptr<DrawCommandBuffer>> threadBuffers_;
+    static std::mutex threadBuffersMutex_;
+
+    static std::thread renderThread_;
+    static std::mutex packetMutex_;
+    static std::condition_variable packetReady_;
+    static std::condition_variable packetConsumed_;
+    static std::deque<FramePacket> pendingPackets_;
+    static std::vector<std::vector<DrawItem>> freeItemBuffers_;
+    static std::unique_ptr<FrameArena> frameArena_;
+    static std::vector<std::unique_ptr<FrameArena>> freeArenas_;
+    static size_t arenaHighWater_;
+    static uint32_t maxQueuedFrames_;
+    static uint32_t peakQueuedFrames_;
+    static bool renderThreadRunning_;
+
+    struct PendingUpload
+    {
+        std::function<void()> task;
+        size_t* remaining = nullptr;
+    };
+
+    static constexpr double kUploadBudgetMs = 4.0;
+    static std::deque<PendingUpload> pendingUploads_;
+    static std::condition_variable uploadsDone_;
+    static std::thread::id backendThread_;
 };
@@ -0,0 +1,882 @@
+#include "SoftwareRenderBackend.hpp"
+
+#include "../Base/ThreadPool.hpp"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+    constexpr uint64_t kTextCacheLifetime = 120;
+
+    uint16_t ToModulate(float value)
+    {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 256.0f));
+    }
+
+    void BlendPixels4(uint32_t* dst, const uint32_t* src, __m128i modulate)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i k256 = _mm_set1_epi16(256);
+
+        const __m128i s = _mm_load_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst));
+
+        const __m128i sLo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), modulate), 8);
+        const __m128i sHi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), modulate), 8);
+
+        const __m128i invLo = _mm_sub_epi16(k256, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, 0xFF), 0xFF));
+        const __m128i invHi = _mm_sub_epi16(k256, _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, 0xFF), 0xFF));
+
+        const __m128i dLo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), invLo), 8);
+        const __m128i dHi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), invHi), 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_packus_epi16(_mm_add_epi16(sLo, dLo), _mm_add_epi16(sHi, dHi)));
+    }
+
+    void BlendPixels(uint32_t* dst, const uint32_t* src, int32_t count, __m128i modulate)
+    {
+        if (count == 4)
+        {
+            BlendPixels4(dst, src, modulate);
+            return;
+        }
+
+        alignas(16) uint32_t tmp[4] = {};
+        std::copy_n(dst, count, tmp);
+        BlendPixels4(tmp, src, modulate);
+        std::copy_n(tmp, count, dst);
+    }
+
+    // Blends two premultiplied BGRA texels, two channels at a time; weight is in 1/256 steps.
+    uint32_t LerpTexel(uint32_t a, uint32_t b, uint32_t weight)
+    {
+        const uint32_t inverse = 256 - weight;
+        const uint32_t rb = (((a & 0x00FF00FF) * inverse + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+        const uint32_t ag = ((a >> 8 & 0x00FF00FF) * inverse + (b >> 8 & 0x00FF00FF) * weight) & 0xFF00FF00;
+        return rb | ag;
+    }
+}
+
+SoftwareRenderBackend::~SoftwareRenderBackend()
+{
+    SoftwareRenderBackend::Shutdown();
+}
+
+bool SoftwareRenderBackend::Initialize(void* windowHandle)
+{
+    const bool result = CreateDeviceResources(windowHandle);
+    if (!result)
+    {
+        std::cerr << "ERROR: Failed to create software render target\n";
+    }
+    return result;
+}
+
+void SoftwareRenderBackend::Shutdown()
+{
+    std::lock_guard lock(mutex_);
+
+    DiscardDeviceResources();
+    textFormatCache_.clear();
+    textCache_.clear();
+}
+
+bool SoftwareRenderBackend::CreateDeviceResources(void* windowHandle)
+{
+    std::lock_guard lock(mutex_);
+
+    hwnd_ = static_cast<HWND>(windowHandle);
+
+    uint32_t width = width_ ? width_ : 1280;
+    uint32_t height = height_ ? height_ : 720;
+    if (hwnd_)
+    {
+        RECT rc;
+        if (GetClientRect(hwnd_, &rc) && rc.right > rc.left && rc.bottom > rc.top)
+        {
+            width = static_cast<uint32_t>(rc.right - rc.left);
+            height = static_cast<uint32_t>(rc.bottom - rc.top);
+        }
+    }
+
+    Resize(width, height);
+    return !framebuffer_.empty();
+}
+
+void SoftwareRenderBackend::DiscardDeviceResources()
+{
+    std::lock_guard lock(mutex_);
+
+    commands_.clear();
+    targetCommands_.clear();
+    renderTarget_.reset();
+    tileBins_.clear();
+    framebuffer_.clear();
+    framebuffer_.shrink_to_fit();
+}
+
+void SoftwareRenderBackend::Resize(uint32_t width, uint32_t height)
+{
+    std::lock_guard lock(mutex_);
+    if (width == 0 || height == 0) return;
+
+    width_ = width;
+    height_ = height;
+    framebuffer_.assign(static_cast<size_t>(width_) * height_, 0xFF000000u);
+
+    tilesX_ = (width_ + kTileSize - 1) / kTileSize;
+    tilesY_ = (height_ + kTileSize - 1) / kTileSize;
+    tileBins_.assign(static_cast<size_t>(tilesX_) * tilesY_, {});
+}
+
+void SoftwareRenderBackend::BeginFrame()
+{
+    std::lock_guard lock(mutex_);
+
+    if (framebuffer_.empty())
+    {
+        CreateDeviceResources(hwnd_);
+        if (framebuffer_.empty()) return;
+    }
+
+    commands_.clear();
+}
+
+void SoftwareRenderBackend::EndFrame()
+{
+    std::lock_guard lock(mutex_);
+    if (framebuffer_.empty()) return;
+
+    if (renderTarget_)
+        SetRenderTarget(nullptr);
+
+    for (auto& bin : tileBins_)
+        bin.clear();
+
+    for (uint32_t i = 0; i < commands_.size(); ++i)
+    {
+        const auto& cmd = commands_[i];
+        if (cmd.type == CommandType::Clear)
+        {
+            for (auto& bin : tileBins_)
+                bin.push_back(i);
+            continue;
+        }
+
+        const uint32_t tx0 = static_cast<uint32_t>(cmd.minX) / kTileSize;
+        const uint32_t ty0 = static_cast<uint32_t>(cmd.minY) / kTileSize;
+        const uint32_t tx1 = static_cast<uint32_t>(cmd.maxX - 1) / kTileSize;
+        const uint32_t ty1 = static_cast<uint32_t>(cmd.maxY - 1) / kTileSize;
+
+        for (uint32_t ty = ty0; ty <= ty1; ++ty)
+        {
+            for (uint32_t tx = tx0; tx <= tx1; ++tx)
+            {
+                tileBins_[ty * tilesX_ + tx].push_back(i);
+            }
+        }
+    }
+
+    std::vector<uint32_t> activeTiles;
+    activeTiles.reserve(tileBins_.size());
+    for (uint32_t t = 0; t < tileBins_.size(); ++t)
+    {
+        if (!tileBins_[t].empty() && (!partialFrame_ || dirtyTiles_[t]))
+            activeTiles.push_back(t);
+    }
+
+    ThreadPool::Shared().ParallelFor(activeTiles.size(), [&](size_t i)
+    {
+        RasterizeTile(activeTiles[i]);
+    });
+
+    Present();
+    commands_.clear();
+    partialFrame_ = false;
+
+    std::erase_if(textCache_, [this](const auto& entry)
+    {
+        return frameIndex_ - entry.second.lastUsedFrame > kTextCacheLifetime;
+    });
+    ++frameIndex_;
+}
+
+void SoftwareRenderBackend::Clear(const Color& color)
+{
+    std::lock_guard lock(mutex_);
+
+    RasterCommand cmd;
+    cmd.type = CommandType::Clear;
+    cmd.color = renderTarget_
+                    ? PackColor(color)
+                    : PackColor(Color(color.value.r, color.value.g, color.value.b, 1.0f));
+    ActiveCommands().push_back(std::move(cmd));
+}
+
+void SoftwareRenderBackend::SetDirtyRegion(const std::vector<Rect>& rects)
+{
+    std::lock_guard lock(mutex_);
+
+    partialFrame_ = !rects.empty();
+    if (!partialFrame_) return;
+
+    dirtyTiles_.assign(tileBins_.size(), 0);
+    for (const auto& rect : rects)
+    {
+        const auto tile = static_cast<float>(kTileSize);
+        const auto tx0 = static_cast<uint32_t>(std::max(0.0f, std::floor(rect.Left() / tile)));
+        const auto ty0 = static_cast<uint32_t>(std::max(0.0f, std::floor(rect.Top() / tile)));
+        const uint32_t tx1 = std::min(tilesX_, static_cast<uint32_t>(std::max(0.0f, std::ceil(rect.Right() / tile))));
+        const uint32_t ty1 = std::min(tilesY_, static_cast<uint32_t>(std::max(0.0f, std::ceil(rect.Bottom() / tile))));
+
+        for (uint32_t ty = ty0; ty < ty1; ++ty)
+        {
+            for (uint32_t tx = tx0; tx < tx1; ++tx)
+                dirtyTiles_[ty * tilesX_ + tx] = 1;
+        }
+    }
+}
+
+bool SoftwareRenderBackend::SupportsPartialRedraw() const
+{
+    return true;
+}
+
+std::shared_ptr<ITexture> SoftwareRenderBackend::CreateTexture(const PixelData& data)
+{
+    if (data.pixels.empty() || data.width == 0 || data.height == 0)
+    {
+        std::cerr << "Error: Invalid pixel data in CreateTexture (width=" << data.width << ", height=" << data.height <<
+            ", pixels=" << data.pixels.size() << ")\n";
+        return nullptr;
+    }
+
+    const uint32_t srcPitch = data.pitch ? data.pitch : data.width * 4;
+
+    PixelData converted;
+    converted.width = data.width;
+    converted.height = data.height;
+    converted.pitch = data.width * 4;
+    converted.pixels.resize(static_cast<size_t>(converted.pitch) * data.height);
+
+    for (uint32_t y = 0; y < data.height; ++y)
+    {
+        const uint8_t* src = data.pixels.data() + static_cast<size_t>(y) * srcPitch;
+        uint8_t* dst = converted.pixels.data() + static_cast<size_t>(y) * converted.pitch;
+        for (uint32_t x = 0; x < data.width; ++x)
+        {
+            dst[x * 4 + 0] = src[x * 4 + 2];
+            dst[x * 4 + 1] = src[x * 4 + 1];
+            dst[x * 4 + 2] = src[x * 4 + 0];
+            dst[x * 4 + 3] = src[x * 4 + 3];
+        }
+    }
+
+    return std::make_shared<SoftwareTexture>(std::move(converted));
+}
+
+bool SoftwareRenderBackend::UpdateTexture(ITexture* texture, const PixelData& data, uint32_t x, uint32_t y)
+{
+    std::lock_guard lock(mutex_);
+
+    const auto swTexture = dynamic_cast<SoftwareTexture*>(texture);
+    if (!swTexture || data.pixels.empty()) return false;
+
+    PixelData& target = swTexture->GetMutablePixels();
+    if (x + data.width > target.width || y + data.height > target.height) return false;
+
+    const uint32_t srcPitch = data.pitch ? data.pitch : data.width * 4;
+    for (uint32_t row = 0; row < data.height; ++row)
+    {
+        const uint8_t* src = data.pixels.data() + static_cast<size_t>(row) * srcPitch;
+        uint8_t* dst = target.pixels.data() + static_cast<size_t>(y + row) * target.pitch + x * 4;
+        for (uint32_t col = 0; col < data.width; ++col)
+        {
+            dst[col * 4 + 0] = src[col * 4 + 2];
+            dst[col * 4 + 1] = src[col * 4 + 1];
+            dst[col * 4 + 2] = src[col * 4 + 0];
+            dst[col * 4 + 3] = src[col * 4 + 3];
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<ITexture> SoftwareRenderBackend::CreateRenderTarget(uint32_t width, uint32_t height)
+{
+    if (width == 0 || height == 0) return nullptr;
+
+    PixelData data;
+    data.width = width;
+    data.height = height;
+    data.pitch = width * 4;
+    data.pixels.assign(static_cast<size_t>(data.pitch) * height, 0);
+
+    return std::make_shared<SoftwareTexture>(std::move(data));
+}
+
+void SoftwareRenderBackend::SetRenderTarget(ITexture* target)
+{
+    std::lock_guard lock(mutex_);
+
+    if (renderTarget_)
+    {
+        RasterizeTarget();
+        renderTarget_.reset();
+    }
+
+    if (const auto swTexture = dynamic_cast<SoftwareTexture*>(target))
+        renderTarget_ = swTexture->shared_from_this();
+}
+
+std::shared_ptr<ITextFormat> SoftwareRenderBackend::CreateTextFormat(
+    const std::wstring& fontFamily,
+    float fontSize)
+{
+    std::lock_guard lock(mutex_);
+
+    const std::wstring key = fontFamily + L"|" + std::to_wstring(fontSize);
+
+    const auto it = textFormatCache_.find(key);
+    if (it != textFormatCache_.end())
+        return it->second;
+
+    const HFONT font = CreateFontW(
+        -static_cast<int>(std::lround(fontSize)),
+        0, 0, 0,
+        FW_NORMAL,
+        FALSE, FALSE, FALSE,
+        DEFAULT_CHARSET,
+        OUT_DEFAULT_PRECIS,
+        CLIP_DEFAULT_PRECIS,
+        ANTIALIASED_QUALITY,
+        DEFAULT_PITCH | FF_DONTCARE,
+        fontFamily.c_str());
+
+    if (!font) return nullptr;
+
+    auto textFormat = std::make_shared<GdiTextFormat>(font);
+    textFormat->SetDescription(fontFamily, fontSize);
+    textFormatCache_[key] = textFormat;
+    return textFormat;
+}
+
+void SoftwareRenderBackend::DrawTexture(
+    ITexture* texture,
+    const Affine2D& transform,
+    float opacity,
+    const Color& tint)
+{
+    std::lock_guard lock(mutex_);
+
+    const auto swTexture = dynamic_cast<SoftwareTexture*>(texture);
+    if (!swTexture) return;
+
+    const auto size = swTexture->GetSize();
+    RecordTexture(swTexture, transform_ * transform, Rect(0.0f, 0.0f, size.x, size.y), opacity, tint);
+}
+
+void SoftwareRenderBackend::DrawTextureRect(
+    ITexture* texture,
+    const Affine2D& transform,
+    const Rect& sourceRect,
+    float opacity,
+    const Color& tint)
+{
+    std::lock_guard lock(mutex_);
+
+    const auto swTexture = dynamic_cast<SoftwareTexture*>(texture);
+    if (!swTexture) return;
+
+    RecordTexture(swTexture, transform_ * transform, sourceRect, opacity, tint);
+}
+
+void SoftwareRenderBackend::DrawTexts(
+    std::wstring_view text,
+    const Rect& layoutRect,
+    ITextFormat* textFormat,
+    const Color& color,
+    Justification justification)
+{
+    std::lock_guard lock(mutex_);
+
+    if (text.empty() || !textFormat) return;
+
+    const auto gdiFormat = dynamic_cast<GdiTextFormat*>(textFormat);
+    if (!gdiFormat) return;
+
+    const auto texture = RasterizeText(text, layoutRect, gdiFormat, color, justification);
+    if (!texture) return;
+
+    const Affine2D offset = MatrixHelper::Translation({layoutRect.Left(), layoutRect.Top()});
+
+    const auto size = texture->GetSize();
+    RecordTexture(texture.get(), transform_ * offset, Rect(0.0f, 0.0f, size.x, size.y), 1.0f, Color::White);
+}
+
+void SoftwareRenderBackend::DrawRectangle(
+    const Rect& rect,
+    const Color& color,
+    float strokeWidth,
+    bool filled)
+{
+    std::lock_guard lock(mutex_);
+
+    if (filled)
+    {
+        RecordFill(rect, color);
+        return;
+    }
+
+    const float h = strokeWidth * 0.5f;
+    RecordFill(Rect(rect.Left() - h, rect.Top() - h, rect.Right() + h, rect.Top() + h), color);
+    RecordFill(Rect(rect.Left() - h, rect.Bottom() - h, rect.Right() + h, rect.Bottom() + h), color);
+    RecordFill(Rect(rect.Left() - h, rect.Top() + h, rect.Left() + h, rect.Bottom() - h), color);
+    RecordFill(Rect(rect.Right() - h, rect.Top() + h, rect.Right() + h, rect.Bottom() - h), color);
+}
+
+void SoftwareRenderBackend::SetTransform(const Affine2D& transform)
+{
+    std::lock_guard lock(mutex_);
+    transform_ = transform;
+}
+
+Affine2D SoftwareRenderBackend::GetTransform() const
+{
+    std::lock_guard lock(mutex_);
+    return transform_;
+}
+
+void SoftwareRenderBackend::Lock()
+{
+    mutex_.lock();
+}
+
+void SoftwareRenderBackend::Unlock()
+{
+    mutex_.unlock();
+}
+
+std::vector<SoftwareRenderBackend::RasterCommand>& SoftwareRenderBackend::ActiveCommands()
+{
+    return renderTarget_ ? targetCommands_ : commands_;
+}
+
+int32_t SoftwareRenderBackend::ActiveWidth() const
+{
+    return static_cast<int32_t>(renderTarget_ ? renderTarget_->GetPixels().width : width_);
+}
+
+int32_t SoftwareRenderBackend::ActiveHeight() const
+{
+    return static_cast<int32_t>(renderTarget_ ? renderTarget_->GetPixels().height : height_);
+}
+
+void SoftwareRenderBackend::RecordTexture(SoftwareTexture* texture, const Affine2D& transform,
+                                          const Rect& sourceRect, float opacity, const Color& tint)
+{
+    if (framebuffer_.empty() || texture == renderTarget_.get()) return;
+
+    const float m11 = transform.m11;
+    const float m12 = transform.m12;
+    const float m21 = transform.m21;
+    const float m22 = transform.m22;
+    const float dx = transform.dx;
+    const float dy = transform.dy;
+
+    if (std::abs(transform.Determinant()) < 1e-8f) return;
+
+    const float w = sourceRect.Width();
+    const float h = sourceRect.Height();
+    if (w <= 0.0f || h <= 0.0f) return;
+
+    const float xs[4] = {dx, w * m11 + dx, h * m21 + dx, w * m11 + h * m21 + dx};
+    const float ys[4] = {dy, w * m12 + dy, h * m22 + dy, w * m12 + h * m22 + dy};
+
+    const float minX = std::min({xs[0], xs[1], xs[2], xs[3]});
+    const float maxX = std::max({xs[0], xs[1], xs[2], xs[3]});
+    const float minY = std::min({ys[0], ys[1], ys[2], ys[3]});
+    const float maxY = std::max({ys[0], ys[1], ys[2], ys[3]});
+
+    RasterCommand cmd;
+    cmd.minX = std::max(0, static_cast<int32_t>(std::floor(minX)));
+    cmd.minY = std::max(0, static_cast<int32_t>(std::floor(minY)));
+    cmd.maxX = std::min(ActiveWidth(), static_cast<int32_t>(std::ceil(maxX)));
+    cmd.maxY = std::min(ActiveHeight(), static_cast<int32_t>(std::ceil(maxY)));
+    if (cmd.minX >= cmd.maxX || cmd.minY >= cmd.maxY) return;
+
+    const float alpha = std::clamp(tint.value.a, 0.0f, 1.0f) * std::clamp(opacity, 0.0f, 1.0f);
+    if (alpha <= 0.0f) return;
+
+    cmd.type = CommandType::Texture;
+    cmd.texture = texture->shared_from_this();
+    const Affine2D inverse = transform.Inverse();
+    cmd.inv11 = inverse.m11;
+    cmd.inv12 = inverse.m12;
+    cmd.inv21 = inverse.m21;
+    cmd.inv22 = inverse.m22;
+    cmd.invDx = inverse.dx;
+    cmd.invDy = inverse.dy;
+    cmd.srcX = sourceRect.Left();
+    cmd.srcY = sourceRect.Top();
+    cmd.srcW = w;
+    cmd.srcH = h;
+    // Unscaled draws on whole-pixel offsets hit texel centers exactly, where filtering changes nothing.
+    cmd.bilinear = inverse.m11 != 1.0f || inverse.m12 != 0.0f || inverse.m21 != 0.0f || inverse.m22 != 1.0f ||
+        inverse.dx != std::floor(inverse.dx) || inverse.dy != std::floor(inverse.dy);
+    cmd.modulate[0] = ToModulate(tint.value.b * alpha);
+    cmd.modulate[1] = ToModulate(tint.value.g * alpha);
+    cmd.modulate[2] = ToModulate(tint.value.r * alpha);
+    cmd.modulate[3] = ToModulate(alpha);
+
+    ActiveCommands().push_back(std::move(cmd));
+}
+
+void SoftwareRenderBackend::RecordFill(const Rect& rect, const Color& color)
+{
+    if (framebuffer_.empty() || color.value.a <= 0.0f) return;
+
+    const float xs[4] = {rect.Left(), rect.Right(), rect.Left(), rect.Right()};
+    const float ys[4] = {rect.Top(), rect.Top(), rect.Bottom(), rect.Bottom()};
+
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    for (int i = 0; i < 4; ++i)
+    {
+        const glm::vec2 point = transform_.TransformPoint({xs[i], ys[i]});
+        minX = std::min(minX, point.x);
+        minY = std::min(minY, point.y);
+        maxX = std::max(maxX, point.x);
+        maxY = std::max(maxY, point.y);
+    }
+
+    RasterCommand cmd;
+    cmd.type = CommandType::Fill;
+    cmd.color = PackColor(color);
+    cmd.minX = std::max(0, static_cast<int32_t>(std::ceil(minX - 0.5f)));
+    cmd.minY = std::max(0, static_cast<int32_t>(std::ceil(minY - 0.5f)));
+    cmd.maxX = std::min(ActiveWidth(), static_cast<int32_t>(std::ceil(maxX - 0.5f)));
+    cmd.maxY = std::min(ActiveHeight(), static_cast<int32_t>(std::ceil(maxY - 0.5f)));
+    if (cmd.minX >= cmd.maxX || cmd.minY >= cmd.maxY) return;
+
+    ActiveCommands().push_back(std::move(cmd));
+}
+
+void SoftwareRenderBackend::RasterizeTile(uint32_t tileIndex)
+{
+    const uint32_t tx = tileIndex % tilesX_;
+    const uint32_t ty = tileIndex / tilesX_;
+
+    const auto tileX0 = static_cast<int32_t>(tx * kTileSize);
+    const auto tileY0 = static_cast<int32_t>(ty * kTileSize);
+    const int32_t tileX1 = std::min(tileX0 + static_cast<int32_t>(kTileSize), static_cast<int32_t>(width_));
+    const int32_t tileY1 = std::min(tileY0 + static_cast<int32_t>(kTileSize), static_cast<int32_t>(height_));
+
+    for (const uint32_t index : tileBins_[tileIndex])
+    {
+        const auto& cmd = commands_[index];
+
+        if (cmd.type == CommandType::Clear)
+        {
+            for (int32_t y = tileY0; y < tileY1; ++y)
+            {
+                std::fill_n(framebuffer_.data() + static_cast<size_t>(y) * width_ + tileX0, tileX1 - tileX0,
+                            cmd.color);
+            }
+            continue;
+        }
+
+        const int32_t x0 = std::max(tileX0, cmd.minX);
+        const int32_t y0 = std::max(tileY0, cmd.minY);
+        const int32_t x1 = std::min(tileX1, cmd.maxX);
+        const int32_t y1 = std::min(tileY1, cmd.maxY);
+        if (x0 >= x1 || y0 >= y1) continue;
+
+        if (cmd.type == CommandType::Texture)
+            RasterizeTexture(cmd, framebuffer_.data(), width_, x0, y0, x1, y1);
+        else
+            RasterizeFill(cmd, framebuffer_.data(), width_, x0, y0, x1, y1);
+    }
+}
+
+void SoftwareRenderBackend::RasterizeTarget()
+{
+    PixelData& target = renderTarget_->GetMutablePixels();
+    auto* pixels = reinterpret_cast<uint32_t*>(target.pixels.data());
+    const uint32_t stride = target.pitch / 4;
+    const auto width = static_cast<int32_t>(target.width);
+    const auto height = static_cast<int32_t>(target.height);
+    const uint32_t bands = (target.height + kTileSize - 1) / kTileSize;
+
+    ThreadPool::Shared().ParallelFor(bands, [&](size_t band)
+    {
+        const auto bandY0 = static_cast<int32_t>(band * kTileSize);
+        const int32_t bandY1 = std::min(bandY0 + static_cast<int32_t>(kTileSize), height);
+
+        for (const auto& cmd : targetCommands_)
+        {
+            if (cmd.type == CommandType::Clear)
+            {
+                for (int32_t y = bandY0; y < bandY1; ++y)
+                    std::fill_n(pixels + static_cast<size_t>(y) * stride, width, cmd.color);
+                continue;
+            }
+
+            const int32_t y0 = std::max(bandY0, cmd.minY);
+            const int32_t y1 = std::min(bandY1, cmd.maxY);
+            if (y0 >= y1) continue;
+
+            if (cmd.type == CommandType::Texture)
+                RasterizeTexture(cmd, pixels, stride, cmd.minX, y0, cmd.maxX, y1);
+            else
+                RasterizeFill(cmd, pixels, stride, cmd.minX, y0, cmd.maxX, y1);
+        }
+    });
+
+    targetCommands_.clear();
+}
+
+void SoftwareRenderBackend::RasterizeTexture(const RasterCommand& cmd, uint32_t* pixels, uint32_t stride,
+                                             int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    const PixelData& src = cmd.texture->GetPixels();
+    const auto* texels = reinterpret_cast<const uint32_t*>(src.pixels.data());
+    const uint32_t srcStride = src.pitch / 4;
+    const auto originX = static_cast<int32_t>(cmd.srcX);
+    const auto originY = static_cast<int32_t>(cmd.srcY);
+    const int32_t lastX = static_cast<int32_t>(std::ceil(cmd.srcW)) - 1;
+    const int32_t lastY = static_cast<int32_t>(std::ceil(cmd.srcH)) - 1;
+
+    // Matches the linear filtering of the D2D backend, clamped to the source rectangle.
+    const auto sample = [&](float u, float v) -> uint32_t
+    {
+        if (!cmd.bilinear)
+            return texels[static_cast<size_t>(originY + static_cast<int32_t>(v)) * srcStride + originX +
+                static_cast<int32_t>(u)];
+
+        const float fx = u - 0.5f;
+        const float fy = v - 0.5f;
+        const float floorX = std::floor(fx);
+        const float floorY = std::floor(fy);
+        const auto wx = static_cast<uint32_t>((fx - floorX) * 256.0f);
+        const auto wy = static_cast<uint32_t>((fy - floorY) * 256.0f);
+
+        const auto ix = static_cast<int32_t>(floorX);
+        const auto iy = static_cast<int32_t>(floorY);
+        const int32_t x0 = originX + std::clamp(ix, 0, lastX);
+        const int32_t x1 = originX + std::clamp(ix + 1, 0, lastX);
+        const uint32_t* row0 = texels + static_cast<size_t>(originY + std::clamp(iy, 0, lastY)) * srcStride;
+        const uint32_t* row1 = texels + static_cast<size_t>(originY + std::clamp(iy + 1, 0, lastY)) * srcStride;
+
+        return LerpTexel(LerpTexel(row0[x0], row0[x1], wx), LerpTexel(row1[x0], row1[x1], wx), wy);
+    };
+
+    const __m128i modulate = _mm_setr_epi16(
+        static_cast<short>(cmd.modulate[0]), static_cast<short>(cmd.modulate[1]),
+        static_cast<short>(cmd.modulate[2]), static_cast<short>(cmd.modulate[3]),
+        static_cast<short>(cmd.modulate[0]), static_cast<short>(cmd.modulate[1]),
+        static_cast<short>(cmd.modulate[2]), static_cast<short>(cmd.modulate[3]));
+
+    alignas(16) uint32_t gathered[4];
+
+    for (int32_t y = y0; y < y1; ++y)
+    {
+        const float px = static_cast<float>(x0) + 0.5f;
+        const float py = static_cast<float>(y) + 0.5f;
+        float u = cmd.inv11 * px + cmd.inv21 * py + cmd.invDx;
+        float v = cmd.inv12 * px + cmd.inv22 * py + cmd.invDy;
+
+        uint32_t* row = pixels + static_cast<size_t>(y) * stride;
+
+        for (int32_t x = x0; x < x1; x += 4)
+        {
+            const int32_t count = std::min(4, x1 - x);
+            uint32_t any = 0;
+
+            for (int32_t i = 0; i < 4; ++i)
+            {
+                uint32_t texel = 0;
+                if (i < count && u >= 0.0f && v >= 0.0f && u < cmd.srcW && v < cmd.srcH)
+                    texel = sample(u, v);
+                gathered[i] = texel;
+                any |= texel;
+                u += cmd.inv11;
+                v += cmd.inv12;
+            }
+
+            if (any)
+                BlendPixels(row + x, gathered, count, modulate);
+        }
+    }
+}
+
+void SoftwareRenderBackend::RasterizeFill(const RasterCommand& cmd, uint32_t* pixels, uint32_t stride,
+                                          int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    if (cmd.color >> 24 == 0xFF)
+    {
+        for (int32_t y = y0; y < y1; ++y)
+        {
+            std::fill_n(pixels + static_cast<size_t>(y) * stride + x0, x1 - x0, cmd.color);
+        }
+        return;
+    }
+
+    const __m128i modulate = _mm_set1_epi16(256);
+    alignas(16) const uint32_t source[4] = {cmd.color, cmd.color, cmd.color, cmd.color};
+
+    for (int32_t y = y0; y < y1; ++y)
+    {
+        uint32_t* row = pixels + static_cast<size_t>(y) * stride;
+        for (int32_t x = x0; x < x1; x += 4)
+        {
+            BlendPixels(row + x, source, std::min(4, x1 - x), modulate);
+        }
+    }
+}
+
+void SoftwareRenderBackend::Present()
+{
+    if (!hwnd_) return;
+
+    BITMAPINFO bmi{};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = static_cast<LONG>(width_);
+    bmi.bmiHeader.biHeight = -static_cast<LONG>(height_);
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    const HDC dc = GetDC(hwnd_);
+    if (!dc) return;
+
+    SetDIBitsToDevice(dc, 0, 0, width_, height_, 0, 0, 0, height_, framebuffer_.data(), &bmi, DIB_RGB_COLORS);
+    ReleaseDC(hwnd_, dc);
+}
+
+std::shared_ptr<SoftwareTexture> SoftwareRenderBackend::RasterizeText(std::wstring_view text,
+                                                                      const Rect& layoutRect,
+                                                                      GdiTextFormat* format,
+                                                                      const Color& color,
+                                                                      Justification justification)
+{
+    const int width = std::max(1, static_cast<int>(std::ceil(layoutRect.Width())));
+    const int height = std::max(1, static_cast<int>(std::ceil(layoutRect.Height())));
+
+    const std::wstring key = std::wstring(text) + L"|" +
+        std::to_wstring(reinterpret_cast<uintptr_t>(format->GetFont())) + L"|" + std::to_wstring(PackColor(color)) +
+        L"|" + std::to_wstring(width) + L"x" + std::to_wstring(height) +
+        L"|" + std::to_wstring(static_cast<int>(justification));
+
+    if (const auto it = textCache_.find(key); it != textCache_.end())
+    {
+        it->second.lastUsedFrame = frameIndex_;
+        return it->second.texture;
+    }
+
+    BITMAPINFO bmi{};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = width;
+    bmi.bmiHeader.biHeight = -height;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+
+    const HDC dc = CreateCompatibleDC(nullptr);
+    if (!dc) return nullptr;
+
+    void* bits = nullptr;
+    const HBITMAP bitmap = CreateDIBSection(dc, &bmi, DIB_RGB_COLORS, &bits, nullptr, 0);
+    if (!bitmap || !bits)
+    {
+        DeleteDC(dc);
+        return nullptr;
+    }
+
+    const HGDIOBJ oldBitmap = SelectObject(dc, bitmap);
+    const HGDIOBJ oldFont = SelectObject(dc, format->GetFont());
+    std::memset(bits, 0, static_cast<size_t>(width) * height * 4);
+
+    SetBkMode(dc, TRANSPARENT);
+    SetTextColor(dc, RGB(255, 255, 255));
+
+    UINT flags = DT_NOPREFIX;
+    switch (justification)
+    {
+    case Justification::Right:
+    case Justification::RightVerticalMiddle:
+        flags |= DT_RIGHT;
+        break;
+    case Justification::Center:
+    case Justification::CenterVerticalMiddle:
+        flags |= DT_CENTER;
+        break;
+    case Justification::Left:
+    case Justification::LeftVerticalMiddle:
+    default:
+        flags |= DT_LEFT;
+        break;
+    }
+
+    switch (justification)
+    {
+    case Justification::LeftVerticalMiddle:
+    case Justification::RightVerticalMiddle:
+    case Justification::CenterVerticalMiddle:
+        flags |= DT_VCENTER | DT_SINGLELINE;
+        break;
+    default:
+        flags |= DT_TOP | DT_WORDBREAK;
+        break;
+    }
+
+    RECT rc{0, 0, width, height};
+    DrawTextW(dc, text.data(), static_cast<int>(text.size()), &rc, flags);
+    GdiFlush();
+
+    PixelData data;
+    data.width = static_cast<uint32_t>(width);
+    data.height = static_cast<uint32_t>(height);
+    data.pitch = data.width * 4;
+    data.pixels.resize(static_cast<size_t>(data.pitch) * data.height);
+
+    const float alpha = std::clamp(color.value.a, 0.0f, 1.0f);
+    const auto* coverage = static_cast<const uint8_t*>(bits);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+    {
+        const uint8_t c = std::max({coverage[i * 4 + 0], coverage[i * 4 + 1], coverage[i * 4 + 2]});
+        const float a = static_cast<float>(c) / 255.0f * alpha;
+        data.pixels[i * 4 + 0] = static_cast<uint8_t>(std::clamp(color.value.b, 0.0f, 1.0f) * a * 255.0f + 0.5f);
+        data.pixels[i * 4 + 1] = static_cast<uint8_t>(std::clamp(color.value.g, 0.0f, 1.0f) * a * 255.0f + 0.5f);
+        data.pixels[i * 4 + 2] = static_cast<uint8_t>(std::clamp(color.value.r, 0.0f, 1.0f) * a * 255.0f + 0.5f);
+        data.pixels[i * 4 + 3] = static_cast<uint8_t>(a * 255.0f + 0.5f);
+    }
+
+    SelectObject(dc, oldFont);
+    SelectObject(dc, oldBitmap);
+    DeleteObject(bitmap);
+    DeleteDC(dc);
+
+    auto texture = std::make_shared<SoftwareTexture>(std::move(data));
+    textCache_[key] = {.texture = texture, .lastUsedFrame = frameIndex_};
+    return texture;
+}
+
+uint32_t SoftwareRenderBackend::PackColor(const Color& color)
+{
+    const float a = std::clamp(color.value.a, 0.0f, 1.0f);
+    const auto b = static_cast<uint32_t>(std::clamp(color.value.b, 0.0f, 1.0f) * a * 255.0f + 0.5f);
+    const auto g = static_cast<uint32_t>(std::clamp(color.value.g, 0.0f, 1.0f) * a * 255.0f + 0.5f);
+    const auto r = static_cast<uint32_t>(std::clamp(color.value.r, 0.0f, 1.0f) * a * 255.0f + 0.5f);
+    const auto alpha = static_cast<uint32_t>(a * 255.0f + 0.5f);
+    return b | g << 8 | r << 16 | alpha << 24;
+}
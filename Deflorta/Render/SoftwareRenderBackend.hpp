@@ -0,0 +1,193 @@
+#pragma once
+
+#include "IRenderBackend.hpp"
+
+#include <Windows.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class SoftwareTexture : public ITexture, public std::enable_shared_from_this<SoftwareTexture>
+{
+public:
+    explicit SoftwareTexture(PixelData data)
+        : data_(std::move(data))
+    {
+    }
+
+    glm::vec2 GetSize() const override
+    {
+        return {static_cast<float>(data_.width), static_cast<float>(data_.height)};
+    }
+
+    void* GetNativeHandle() const override
+    {
+        return const_cast<PixelData*>(&data_);
+    }
+
+    const PixelData& GetPixels() const { return data_; }
+    PixelData& GetMutablePixels() { return data_; }
+
+private:
+    PixelData data_;
+};
+
+class GdiTextFormat : public ITextFormat
+{
+public:
+    explicit GdiTextFormat(HFONT font)
+        : font_(font)
+    {
+    }
+
+    ~GdiTextFormat() override
+    {
+        if (font_) DeleteObject(font_);
+    }
+
+    void* GetNativeHandle() const override
+    {
+        return font_;
+    }
+
+    HFONT GetFont() const { return font_; }
+
+private:
+    HFONT font_ = nullptr;
+};
+
+class SoftwareRenderBackend : public IRenderBackend
+{
+public:
+    SoftwareRenderBackend() = default;
+    ~SoftwareRenderBackend() override;
+
+    bool Initialize(void* windowHandle) override;
+    void Shutdown() override;
+
+    bool CreateDeviceResources(void* windowHandle) override;
+    void DiscardDeviceResources() override;
+    void Resize(uint32_t width, uint32_t height) override;
+
+    void BeginFrame() override;
+    void EndFrame() override;
+    void Clear(const Color& color) override;
+    void SetDirtyRegion(const std::vector<Rect>& rects) override;
+    bool SupportsPartialRedraw() const override;
+
+    std::shared_ptr<ITexture> CreateTexture(const PixelData& data) override;
+    std::shared_ptr<ITexture> CreateRenderTarget(uint32_t width, uint32_t height) override;
+    bool UpdateTexture(ITexture* texture, const PixelData& data, uint32_t x, uint32_t y) override;
+    void SetRenderTarget(ITexture* target) override;
+    std::shared_ptr<ITextFormat> CreateTextFormat(
+        const std::wstring& fontFamily,
+        float fontSize) override;
+
+    void DrawTexture(
+        ITexture* texture,
+        const Affine2D& transform,
+        float opacity,
+        const Color& tint) override;
+
+    void DrawTextureRect(
+        ITexture* texture,
+        const Affine2D& transform,
+        const Rect& sourceRect,
+        float opacity,
+        const Color& tint) override;
+
+    void DrawTexts(
+        std::wstring_view text,
+        const Rect& layoutRect,
+        ITextFormat* textFormat,
+        const Color& color,
+        Justification justification) override;
+
+    void DrawRectangle(
+        const Rect& rect,
+        const Color& color,
+        float strokeWidth,
+        bool filled = false) override;
+
+    void SetTransform(const Affine2D& transform) override;
+    Affine2D GetTransform() const override;
+
+    void Lock() override;
+    void Unlock() override;
+
+private:
+    static constexpr uint32_t kTileSize = 64;
+
+    enum class CommandType : std::uint8_t
+    {
+        Clear,
+        Texture,
+        Fill
+    };
+
+    struct RasterCommand
+    {
+        CommandType type = CommandType::Texture;
+        std::shared_ptr<SoftwareTexture> texture;
+        // Inverse of the sprite transform: maps pixel centers back into source texels.
+        float inv11 = 1.0f, inv12 = 0.0f, inv21 = 0.0f, inv22 = 1.0f, invDx = 0.0f, invDy = 0.0f;
+        float srcX = 0.0f, srcY = 0.0f, srcW = 0.0f, srcH = 0.0f;
+        bool bilinear = false;
+        uint16_t modulate[4] = {256, 256, 256, 256};
+        uint32_t color = 0;
+        int32_t minX = 0, minY = 0, maxX = 0, maxY = 0;
+    };
+
+    struct TextCacheEntry
+    {
+        std::shared_ptr<SoftwareTexture> texture;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    void RecordTexture(SoftwareTexture* texture, const Affine2D& transform, const Rect& sourceRect,
+                       float opacity, const Color& tint);
+    void RecordFill(const Rect& rect, const Color& color);
+    void RasterizeTile(uint32_t tileIndex);
+    void RasterizeTarget();
+    static void RasterizeTexture(const RasterCommand& cmd, uint32_t* pixels, uint32_t stride,
+                                 int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+    static void RasterizeFill(const RasterCommand& cmd, uint32_t* pixels, uint32_t stride,
+                              int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+    void Present();
+
+    std::vector<RasterCommand>& ActiveCommands();
+    int32_t ActiveWidth() const;
+    int32_t ActiveHeight() const;
+
+    std::shared_ptr<SoftwareTexture> RasterizeText(std::wstring_view text, const Rect& layoutRect,
+                                                   GdiTextFormat* format, const Color& color,
+                                                   Justification justification);
+
+    static uint32_t PackColor(const Color& color);
+
+    HWND hwnd_ = nullptr;
+    mutable std::recursive_mutex mutex_;
+
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    std::vector<uint32_t> framebuffer_;
+
+    uint32_t tilesX_ = 0;
+    uint32_t tilesY_ = 0;
+    std::vector<std::vector<uint32_t>> tileBins_;
+    std::vector<RasterCommand> commands_;
+    std::vector<uint8_t> dirtyTiles_;
+    bool partialFrame_ = false;
+
+    std::shared_ptr<SoftwareTexture> renderTarget_;
+    std::vector<RasterCommand> targetCommands_;
+
+    Affine2D transform_{};
+    uint64_t frameIndex_ = 0;
+
+    std::unordered_map<std::wstring, std::shared_ptr<ITextFormat>> textFormatCache_;
+    std::unordered_map<std::wstring, TextCacheEntry> textCache_;
+};
@@ -0,0 +1,69 @@
+#include "StaticLayer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+void StaticLayer::Record(const std::function<void()>& draw)
+{
+    std::vector<DrawItem> captured;
+    Renderer::BeginCapture(&captured);
+    draw();
+    Renderer::EndCapture();
+
+    std::erase_if(captured, [](const DrawItem& item) { return item.drawType == DrawType::CachedLayer; });
+    std::ranges::stable_sort(captured, [](const DrawItem& a, const DrawItem& b) { return a.z < b.z; });
+
+    std::vector<Group> groups;
+    for (auto first = captured.begin(); first != captured.end();)
+    {
+        const int z = first->z;
+        const auto last = std::find_if(first, captured.end(), [z](const DrawItem& item) { return item.z != z; });
+
+        auto items = std::make_shared<std::vector<DrawItem>>(std::make_move_iterator(first),
+                                                             std::make_move_iterator(last));
+        first = last;
+
+        glm::vec2 minPoint = items->front().bounds.min;
+        glm::vec2 maxPoint = items->front().bounds.max;
+        for (const auto& item : *items)
+        {
+            minPoint = glm::min(minPoint, item.bounds.min);
+            maxPoint = glm::max(maxPoint, item.bounds.max);
+        }
+
+        Group group;
+        group.z = z;
+        group.bounds = Rect(std::floor(minPoint.x), std::floor(minPoint.y),
+                            std::ceil(maxPoint.x), std::ceil(maxPoint.y));
+        group.items = std::move(items);
+        if (group.bounds.Width() <= 0.0f || group.bounds.Height() <= 0.0f)
+            continue;
+
+        const auto previous = std::ranges::find(groups_, z, &Group::z);
+        group.cache = previous != groups_.end() ? previous->cache : std::make_shared<RenderLayerCache>();
+        groups.push_back(std::move(group));
+    }
+
+    groups_ = std::move(groups);
+    ++version_;
+}
+
+void StaticLayer::Invalidate()
+{
+    ++version_;
+}
+
+void StaticLayer::Clear()
+{
+    groups_.clear();
+    ++version_;
+}
+
+void StaticLayer::Render(float opacity) const
+{
+    for (const auto& group : groups_)
+    {
+        Renderer::EnqueueCachedLayer(group.cache, group.items, group.bounds, version_, group.z, opacity);
+    }
+}
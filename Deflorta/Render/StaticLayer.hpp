@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Renderer.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class StaticLayer final
+{
+public:
+    void Record(const std::function<void()>& draw);
+    void Invalidate();
+    void Clear();
+    void Render(float opacity = 1.0f) const;
+
+    [[nodiscard]] bool IsEmpty() const { return groups_.empty(); }
+
+private:
+    struct Group
+    {
+        int z = 0;
+        Rect bounds{};
+        std::shared_ptr<const std::vector<DrawItem>> items;
+        std::shared_ptr<RenderLayerCache> cache;
+    };
+
+    std::vector<Group> groups_;
+    uint64_t version_ = 0;
+};
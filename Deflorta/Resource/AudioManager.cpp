@@ -1,5 +1,7 @@
 #include "AudioManager.hpp"
 
+#include "ResourceArchive.hpp"
+
 #include <stb_vorbis.c>
 
 #include <algorithm>
@@ -34,9 +36,13 @@ void AudioManager::Uninitialize()
 
 bool AudioManager::LoadOggFile(const std::string& filePath, AudioData& outData)
 {
+    ArchiveFile file;
+    if (!ResourceArchive::Read(filePath, file)) return false;
+
     int channels, rate;
     short* samples = nullptr;
-    int samplesCount = stb_vorbis_decode_filename(filePath.c_str(), &channels, &rate, &samples);
+    int samplesCount = stb_vorbis_decode_memory(file.Data(), static_cast<int>(file.Size()), &channels, &rate,
+                                                &samples);
 
     if (!samples) return false;
 
@@ -1,6 +1,7 @@
 #include "Foley.hpp"
 
 #include "ResourceManager.hpp"
+#include "ResourceArchive.hpp"
 #include "AudioManager.hpp"
 #include "../Base/Random.hpp"
 #include "../Utils.hpp"
@@ -153,8 +154,11 @@ void Foley::LoadManifest()
     const std::string exeDir = Utils::GetExecutableDir();
     std::string path = (std::filesystem::path(exeDir) / "resources" / "foley.xml").string();
 
+    ArchiveFile file;
     pugi::xml_document doc;
-    const pugi::xml_parse_result result = doc.load_file(path.c_str());
+    const pugi::xml_parse_result result = ResourceArchive::Read(path, file)
+                                              ? doc.load_buffer(file.Data(), file.Size())
+                                              : doc.load_file(path.c_str());
     if (!result)
     {
         std::cerr << "Foley::LoadManifest - Error: Failed to load XML file '" << path
@@ -0,0 +1,258 @@
+#include "LoadQueue.hpp"
+
+#include "ResourceManager.hpp"
+#include "../Render/Renderer.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+std::mutex LoadQueue::mutex_;
+std::condition_variable LoadQueue::workReady_;
+std::condition_variable LoadQueue::jobDone_;
+std::array<std::deque<LoadQueue::Job>, LoadQueue::kPriorityCount> LoadQueue::queues_;
+std::unordered_map<LoadTicket, LoadProgress> LoadQueue::tickets_;
+std::vector<std::thread> LoadQueue::workers_;
+LoadTicket LoadQueue::nextTicket_ = 1;
+uint32_t LoadQueue::activeWorkers_ = 0;
+bool LoadQueue::stopping_ = false;
+
+float LoadProgress::GetFraction() const
+{
+    if (bytesTotal > 0)
+        return static_cast<float>(static_cast<double>(bytesDone) / static_cast<double>(bytesTotal));
+    if (itemsTotal > 0)
+        return static_cast<float>(itemsDone) / static_cast<float>(itemsTotal);
+    return 1.0f;
+}
+
+LoadTicket LoadQueue::CreateTicket()
+{
+    std::lock_guard lock(mutex_);
+    const LoadTicket ticket = nextTicket_++;
+    tickets_[ticket] = {};
+    return ticket;
+}
+
+bool LoadQueue::EnqueueGroup(LoadTicket ticket, const std::string& groupName, LoadPriority priority)
+{
+    std::vector<GroupItem> items;
+    if (!ResourceManager::GetPendingItems(groupName, items)) return false;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        // Files of this group already queued by other tickets move up to the requested priority; the
+        // duplicates queued below then find them loaded and finish immediately.
+        const auto target = static_cast<size_t>(priority);
+        for (size_t p = target + 1; p < kPriorityCount; ++p)
+        {
+            auto& queue = queues_[p];
+            for (auto it = queue.begin(); it != queue.end();)
+            {
+                if (it->group == groupName)
+                {
+                    queues_[target].push_back(std::move(*it));
+                    it = queue.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        for (auto& item : items)
+        {
+            const uint64_t bytes = item.bytes;
+            Push({
+                     .ticket = ticket,
+                     .group = groupName,
+                     .run = [groupName, item = std::move(item)] { return ResourceManager::LoadItem(groupName, item); },
+                     .bytes = bytes
+                 }, priority);
+        }
+        StartWorkers();
+    }
+    workReady_.notify_all();
+    return true;
+}
+
+void LoadQueue::EnqueueTask(LoadTicket ticket, std::function<bool()> task, LoadPriority priority, uint64_t bytes)
+{
+    {
+        std::lock_guard lock(mutex_);
+        Push({.ticket = ticket, .run = std::move(task), .bytes = bytes}, priority);
+        StartWorkers();
+    }
+    workReady_.notify_one();
+}
+
+void LoadQueue::Cancel(LoadTicket ticket)
+{
+    {
+        std::lock_guard lock(mutex_);
+        const auto it = tickets_.find(ticket);
+        if (it == tickets_.end()) return;
+
+        // Jobs already running finish normally; everything still queued is dropped and counted as done.
+        it->second.cancelled = true;
+        it->second.itemsDone += RemoveQueued(ticket);
+    }
+    jobDone_.notify_all();
+}
+
+void LoadQueue::Release(LoadTicket ticket)
+{
+    {
+        std::lock_guard lock(mutex_);
+        RemoveQueued(ticket);
+        tickets_.erase(ticket);
+    }
+    jobDone_.notify_all();
+}
+
+void LoadQueue::Wait(LoadTicket ticket)
+{
+    std::unique_lock lock(mutex_);
+    while (!IsComplete(ticket))
+    {
+        // Help with this ticket's own files instead of idling.
+        if (Job job; PopJob(job, ticket))
+        {
+            lock.unlock();
+            RunJob(job);
+            lock.lock();
+            continue;
+        }
+
+        // The remaining files are on workers, which may be waiting for this thread to upload their textures.
+        lock.unlock();
+        Renderer::PumpBackendTasks();
+        lock.lock();
+        jobDone_.wait_for(lock, std::chrono::milliseconds(1), [ticket] { return IsComplete(ticket); });
+    }
+}
+
+LoadProgress LoadQueue::GetProgress(LoadTicket ticket)
+{
+    std::lock_guard lock(mutex_);
+    const auto it = tickets_.find(ticket);
+    return it != tickets_.end() ? it->second : LoadProgress{};
+}
+
+void LoadQueue::Shutdown()
+{
+    std::vector<std::thread> workers;
+    {
+        std::unique_lock lock(mutex_);
+        stopping_ = true;
+        for (auto& queue : queues_)
+            queue.clear();
+        workReady_.notify_all();
+
+        while (activeWorkers_ > 0)
+        {
+            lock.unlock();
+            Renderer::PumpBackendTasks();
+            lock.lock();
+            jobDone_.wait_for(lock, std::chrono::milliseconds(1), [] { return activeWorkers_ == 0; });
+        }
+        workers = std::move(workers_);
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+void LoadQueue::Push(Job job, LoadPriority priority)
+{
+    if (stopping_) return;
+    if (job.ticket != 0)
+    {
+        const auto it = tickets_.find(job.ticket);
+        if (it == tickets_.end() || it->second.cancelled) return;
+
+        ++it->second.itemsTotal;
+        it->second.bytesTotal += job.bytes;
+    }
+    queues_[static_cast<size_t>(priority)].push_back(std::move(job));
+}
+
+uint32_t LoadQueue::RemoveQueued(LoadTicket ticket)
+{
+    uint32_t count = 0;
+    for (auto& queue : queues_)
+    {
+        const auto removed = std::ranges::remove(queue, ticket, &Job::ticket);
+        count += static_cast<uint32_t>(removed.size());
+        queue.erase(removed.begin(), removed.end());
+    }
+    return count;
+}
+
+bool LoadQueue::IsComplete(LoadTicket ticket)
+{
+    // Released tickets have nothing left to wait for.
+    const auto it = tickets_.find(ticket);
+    return it == tickets_.end() || it->second.IsComplete();
+}
+
+bool LoadQueue::PopJob(Job& outJob, LoadTicket ticket)
+{
+    for (auto& queue : queues_)
+    {
+        const auto it = ticket == 0 ? queue.begin() : std::ranges::find(queue, ticket, &Job::ticket);
+        if (it == queue.end()) continue;
+
+        outJob = std::move(*it);
+        queue.erase(it);
+        return true;
+    }
+    return false;
+}
+
+void LoadQueue::RunJob(Job& job)
+{
+    const bool loaded = job.run();
+    {
+        std::lock_guard lock(mutex_);
+        if (const auto it = tickets_.find(job.ticket); it != tickets_.end())
+        {
+            ++it->second.itemsDone;
+            it->second.bytesDone += job.bytes;
+            if (!loaded) ++it->second.itemsFailed;
+        }
+    }
+    jobDone_.notify_all();
+}
+
+void LoadQueue::StartWorkers()
+{
+    if (!workers_.empty() || stopping_) return;
+
+    // Decoding is CPU-bound; leave cores for the game and render threads.
+    const uint32_t count = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+    for (uint32_t i = 0; i < count; ++i)
+        workers_.emplace_back(WorkerLoop);
+}
+
+void LoadQueue::WorkerLoop()
+{
+    std::unique_lock lock(mutex_);
+    while (!stopping_)
+    {
+        Job job;
+        if (!PopJob(job, 0))
+        {
+            workReady_.wait(lock);
+            continue;
+        }
+
+        ++activeWorkers_;
+        lock.unlock();
+        RunJob(job);
+        lock.lock();
+        --activeWorkers_;
+        jobDone_.notify_all();
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class LoadPriority : std::uint8_t
+{
+    Immediate,
+    NextScene,
+    Background
+};
+
+using LoadTicket = uint64_t;
+
+struct LoadProgress
+{
+    uint32_t itemsDone = 0;
+    uint32_t itemsFailed = 0;
+    uint32_t itemsTotal = 0;
+    uint64_t bytesDone = 0;
+    uint64_t bytesTotal = 0;
+    bool cancelled = false;
+
+    [[nodiscard]] bool IsComplete() const { return itemsDone >= itemsTotal; }
+    [[nodiscard]] float GetFraction() const;
+};
+
+// Background resource loading. Work is queued per file under a ticket, which scenes poll for progress,
+// wait on or cancel. Workers always take the most urgent job first, and re-queueing a group at a higher
+// priority promotes its pending files.
+class LoadQueue final
+{
+public:
+    static LoadTicket CreateTicket();
+    // Ticket 0 queues work that nobody tracks or waits on.
+    static bool EnqueueGroup(LoadTicket ticket, const std::string& groupName, LoadPriority priority);
+    static void EnqueueTask(LoadTicket ticket, std::function<bool()> task, LoadPriority priority,
+                            uint64_t bytes = 0);
+
+    static void Cancel(LoadTicket ticket);
+    static void Wait(LoadTicket ticket);
+    static LoadProgress GetProgress(LoadTicket ticket);
+    // Drops the ticket's queued files and forgets its progress. Call once nothing polls it any more.
+    static void Release(LoadTicket ticket);
+
+    static void Shutdown();
+
+private:
+    struct Job
+    {
+        LoadTicket ticket = 0;
+        std::string group;
+        std::function<bool()> run;
+        uint64_t bytes = 0;
+    };
+
+    static constexpr size_t kPriorityCount = 3;
+
+    static void Push(Job job, LoadPriority priority);
+    static uint32_t RemoveQueued(LoadTicket ticket);
+    static bool IsComplete(LoadTicket ticket);
+    static bool PopJob(Job& outJob, LoadTicket ticket);
+    static void RunJob(Job& job);
+    static void StartWorkers();
+    static void WorkerLoop();
+
+    static std::mutex mutex_;
+    static std::condition_variable workReady_;
+    static std::condition_variable jobDone_;
+    static std::array<std::deque<Job>, kPriorityCount> queues_;
+    static std::unordered_map<LoadTicket, LoadProgress> tickets_;
+    static std::vector<std::thread> workers_;
+    static LoadTicket nextTicket_;
+    static uint32_t activeWorkers_;
+    static bool stopping_;
+};
@@ -1,7 +1,10 @@
 #include "ReanimationLoader.hpp"
 
+#include "ResourceArchive.hpp"
 #include "ResourceManager.hpp"
 #include "../Render/AtlasBuilder.hpp"
+#include "../Render/AtlasCache.hpp"
+#include "../Render/GlobalAtlas.hpp"
 #include "../Utils.hpp"
 
 #include <iostream>
@@ -27,8 +30,11 @@ std::optional<ReanimatorDefinition*> ReanimationLoader::LoadFromFile(const std::
     if (const auto it = loadedReanimations_.find(resolvedPath); it != loadedReanimations_.end())
         return &it->second;
 
+    ArchiveFile file;
     pugi::xml_document doc;
-    const pugi::xml_parse_result result = doc.load_file(resolvedPath.c_str());
+    const pugi::xml_parse_result result = ResourceArchive::Read(resolvedPath, file)
+                                              ? doc.load_buffer(file.Data(), file.Size())
+                                              : doc.load_file(resolvedPath.c_str());
     if (!result)
     {
         std::cerr << "ReanimationLoader: Failed to load XML " << resolvedPath
@@ -74,38 +80,92 @@ std::optional<ReanimatorDefinition*> ReanimationLoader::LoadFromFile(const std::
 
     if (!uniqueImages.empty())
     {
-        AtlasBuilder builder;
-        bool hasImages = false;
-
+        std::vector<std::pair<std::string, std::string>> sources;
+        sources.reserve(uniqueImages.size());
         for (const auto& imageId : uniqueImages)
+            sources.emplace_back(imageId, ResourceManager::GetReanimImagePath(imageId));
+
+        const auto cacheKey = AtlasCache::ComputeKey(sources);
+
+        TextureAtlas atlas;
+        bool baked = cacheKey.IsValid() && AtlasCache::Load(cacheKey, atlas);
+
+        if (!baked)
         {
-            PixelData imageData;
-            if (ResourceManager::LoadReanimImageData(imageId, imageData))
+            AtlasBuilder builder;
+            bool hasImages = false;
+
+            for (const auto& imageId : uniqueImages)
             {
-                builder.AddImage(imageId, imageData);
-                hasImages = true;
+                PixelData imageData;
+                if (ResourceManager::LoadReanimImageData(imageId, imageData))
+                {
+                    builder.AddImage(imageId, imageData, true);
+                    hasImages = true;
+                }
+                else
+                {
+                    std::cerr << "ReanimationLoader: Failed to load image data for '"
+                        << imageId << "' in reanim '" << resolvedPath << "'\n";
+                }
             }
-            else
+
+            baked = hasImages && builder.Build(atlas, 4096, 1, true);
+            if (baked && atlas.dedupedImages > 0)
             {
-                std::cerr << "ReanimationLoader: Failed to load image data for '"
-                    << imageId << "' in reanim '" << resolvedPath << "'\n";
+                std::cout << "ReanimationLoader: '" << path << "' shares " << atlas.dedupedImages
+                    << " duplicate part(s), saving " << atlas.dedupedBytes / 1024 << " KB\n";
             }
+            if (baked && cacheKey.IsValid())
+                AtlasCache::Store(cacheKey, atlas);
         }
 
-        if (hasImages)
+        if (baked)
+            DistributeAtlas(def, atlas, path);
+    }
+
+    auto [it, inserted] = loadedReanimations_.emplace(resolvedPath, std::move(def));
+    return &it->second;
+}
+
+void ReanimationLoader::DistributeAtlas(ReanimatorDefinition& def, const TextureAtlas& atlas, const std::string& path)
+{
+    bool needsPrivateAtlas = false;
+
+    // Deduplicated parts share a spot in the baked atlas; upload each spot to the global atlas once.
+    std::unordered_map<uint64_t, std::shared_ptr<const AtlasEntry>> uploaded;
+
+    for (const auto& [imageId, region] : atlas.regions)
+    {
+        auto entry = GlobalAtlas::Find(imageId);
+        if (!entry)
         {
-            TextureAtlas atlas;
-            if (builder.Build(atlas))
+            const uint64_t spot = static_cast<uint64_t>(region.x) << 32 | region.y;
+            if (const auto it = uploaded.find(spot); it != uploaded.end())
+            {
+                entry = GlobalAtlas::AddAlias(imageId, *it->second, region);
+            }
+            else if (GlobalAtlas::CanHold(region.width, region.height))
             {
-                def.atlasTexture = ResourceManager::CreateTextureFromPixelData(atlas.atlasData);
-                def.atlasRegions = std::move(atlas.regions);
-                def.useAtlas = def.atlasTexture != nullptr;
+                entry = GlobalAtlas::Add(imageId, atlas.ExtractRegion(region), &region);
+                if (entry) uploaded.emplace(spot, entry);
             }
         }
+
+        if (entry)
+            def.atlasEntries.emplace(imageId, *entry);
+        else
+            needsPrivateAtlas = true;
     }
 
-    auto [it, inserted] = loadedReanimations_.emplace(resolvedPath, std::move(def));
-    return &it->second;
+    if (!needsPrivateAtlas) return;
+
+    def.atlasTexture = ResourceManager::CreateTextureFromPixelData(atlas.atlasData);
+    if (!def.atlasTexture) return;
+
+    def.atlasTexture->SetName("reanim:" + path);
+    for (const auto& [imageId, region] : atlas.regions)
+        def.atlasEntries.emplace(imageId, AtlasEntry{def.atlasTexture, region});
 }
 
 ReanimatorTransform ReanimationLoader::ParseTransform(const pugi::xml_node& node)
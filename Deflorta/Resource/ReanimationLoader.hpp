@@ -14,7 +14,8 @@
 constexpr float REANIM_MISSING = -10000.0f;
 
 class ITexture;
-struct AtlasRegion;
+struct AtlasEntry;
+struct TextureAtlas;
 
 struct ReanimatorTransform
 {
@@ -42,9 +43,9 @@ struct ReanimatorDefinition
     std::vector<ReanimatorTrack> tracks;
     float fps = 12.0f;
 
+    // Parts that do not fit the global atlas are packed into this private one instead.
     std::shared_ptr<ITexture> atlasTexture;
-    std::unordered_map<std::string, AtlasRegion> atlasRegions;
-    bool useAtlas = false;
+    std::unordered_map<std::string, AtlasEntry> atlasEntries;
 };
 
 class ReanimationLoader
@@ -55,6 +56,7 @@ public:
 private:
     static ReanimatorTransform ParseTransform(const pugi::xml_node& node);
     static void FillMissingData(ReanimatorTrack& track);
+    static void DistributeAtlas(ReanimatorDefinition& def, const TextureAtlas& atlas, const std::string& path);
 
     static std::unordered_map<std::string, ReanimatorDefinition> loadedReanimations_;
 };
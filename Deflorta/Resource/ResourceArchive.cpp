@@ -0,0 +1,269 @@
+#include "ResourceArchive.hpp"
+
+#include "../Utils.hpp"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t kArchiveMagic = 0x4B504644; // "DFPK"
+    // Must match scripts/pack_resources.py.
+    constexpr uint32_t kArchiveVersion = 1;
+    constexpr uint32_t kEntryCompressed = 1u << 0;
+
+    struct ArchiveHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t indexOffset;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+    };
+}
+
+const uint8_t* ResourceArchive::base_ = nullptr;
+size_t ResourceArchive::size_ = 0;
+std::span<const ResourceArchive::Entry> ResourceArchive::entries_;
+std::string_view ResourceArchive::names_;
+std::filesystem::path ResourceArchive::rootPath_;
+#ifdef _WIN32
+void* ResourceArchive::file_ = nullptr;
+void* ResourceArchive::mapping_ = nullptr;
+#endif
+
+bool ResourceArchive::Open(const std::string& archivePath, const std::string& rootPath)
+{
+    Close();
+    rootPath_ = std::filesystem::path(rootPath).lexically_normal();
+
+    std::error_code ec;
+    if (!std::filesystem::exists(archivePath, ec)) return false;
+    if (!Map(archivePath))
+    {
+        std::cout << "Error: Failed to map resource archive: " << archivePath << "\n";
+        return false;
+    }
+
+    ArchiveHeader header{};
+    if (size_ >= sizeof(header))
+        std::memcpy(&header, base_, sizeof(header));
+
+    const bool valid = size_ >= sizeof(header) && header.magic == kArchiveMagic &&
+        header.version == kArchiveVersion && header.indexOffset % alignof(Entry) == 0 &&
+        header.indexOffset <= size_ && header.entryCount <= (size_ - header.indexOffset) / sizeof(Entry) &&
+        header.namesOffset <= size_ && header.namesSize <= size_ - header.namesOffset;
+    if (!valid)
+    {
+        std::cout << "Error: Invalid or outdated resource archive: " << archivePath << "\n";
+        Close();
+        return false;
+    }
+
+    entries_ = {reinterpret_cast<const Entry*>(base_ + header.indexOffset), header.entryCount};
+    names_ = {reinterpret_cast<const char*>(base_ + header.namesOffset), static_cast<size_t>(header.namesSize)};
+
+    // Validate every entry once so lookups can trust the index.
+    for (const auto& entry : entries_)
+    {
+        if (entry.nameOffset > names_.size() || entry.nameLength > names_.size() - entry.nameOffset ||
+            entry.offset > size_ || entry.storedSize > size_ - entry.offset ||
+            (!(entry.flags & kEntryCompressed) && entry.storedSize != entry.size))
+        {
+            std::cout << "Error: Corrupt entry in resource archive: " << archivePath << "\n";
+            Close();
+            return false;
+        }
+    }
+
+    std::cout << "Mapped resource archive with " << entries_.size() << " files\n";
+    return true;
+}
+
+void ResourceArchive::Close()
+{
+    Unmap();
+    entries_ = {};
+    names_ = {};
+}
+
+bool ResourceArchive::IsOpen()
+{
+    return base_ != nullptr;
+}
+
+bool ResourceArchive::Read(const std::string& path, ArchiveFile& outFile)
+{
+    outFile = {};
+    const std::filesystem::path resolved = ResolvePath(path);
+    if (base_ && ReadFromArchive(resolved, outFile)) return true;
+    return ReadLooseFile(resolved, outFile);
+}
+
+uint64_t ResourceArchive::GetFileSize(const std::string& path)
+{
+    const std::filesystem::path resolved = ResolvePath(path);
+    if (base_)
+    {
+        if (const Entry* entry = FindEntry(resolved))
+            return entry->size;
+    }
+
+    std::error_code ec;
+    const uint64_t size = std::filesystem::file_size(resolved, ec);
+    return ec ? 0 : size;
+}
+
+const ResourceArchive::Entry* ResourceArchive::FindEntry(const std::filesystem::path& path)
+{
+    const std::string name = GetEntryName(path);
+    if (name.empty()) return nullptr;
+
+    const auto it = std::ranges::lower_bound(entries_, std::string_view(name), {}, GetName);
+    if (it == entries_.end() || GetName(*it) != name) return nullptr;
+    return &*it;
+}
+
+bool ResourceArchive::ReadFromArchive(const std::filesystem::path& path, ArchiveFile& outFile)
+{
+    const Entry* it = FindEntry(path);
+    if (!it) return false;
+
+    const std::span<const uint8_t> stored(base_ + it->offset, static_cast<size_t>(it->storedSize));
+    if (!(it->flags & kEntryCompressed))
+    {
+        outFile.mapped_ = stored;
+        return true;
+    }
+
+    outFile.owned_.resize(static_cast<size_t>(it->size));
+    const int decoded = stbi_zlib_decode_buffer(reinterpret_cast<char*>(outFile.owned_.data()),
+                                                static_cast<int>(outFile.owned_.size()),
+                                                reinterpret_cast<const char*>(stored.data()),
+                                                static_cast<int>(stored.size()));
+    if (decoded < 0 || static_cast<uint64_t>(decoded) != it->size)
+    {
+        std::cout << "Error: Failed to decompress '" << GetName(*it) << "' from resource archive\n";
+        outFile.owned_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ResourceArchive::ReadLooseFile(const std::filesystem::path& path, ArchiveFile& outFile)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream) return false;
+
+    outFile.owned_.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    return static_cast<bool>(stream.read(reinterpret_cast<char*>(outFile.owned_.data()),
+                                         static_cast<std::streamsize>(outFile.owned_.size())));
+}
+
+std::filesystem::path ResourceArchive::ResolvePath(const std::string& path)
+{
+    std::filesystem::path resolved(path);
+    if (!resolved.is_absolute())
+        resolved = std::filesystem::path(Utils::GetExecutableDir()) / resolved;
+    return resolved.lexically_normal();
+}
+
+std::string ResourceArchive::GetEntryName(const std::filesystem::path& path)
+{
+    const std::filesystem::path relative = path.lexically_relative(rootPath_);
+    if (relative.empty() || *relative.begin() == "..") return {};
+
+    // Names are stored lower-case with forward slashes, matching the case-insensitive lookups on Windows.
+    std::string name = relative.generic_string();
+    for (auto& c : name)
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return name;
+}
+
+std::string_view ResourceArchive::GetName(const Entry& entry)
+{
+    return names_.substr(entry.nameOffset, entry.nameLength);
+}
+
+bool ResourceArchive::Map(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+    const HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    file_ = file;
+
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Unmap();
+        return false;
+    }
+
+    mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_)
+    {
+        Unmap();
+        return false;
+    }
+
+    base_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!base_)
+    {
+        Unmap();
+        return false;
+    }
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return false;
+
+    base_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(info.st_size);
+    return true;
+#endif
+}
+
+void ResourceArchive::Unmap()
+{
+#ifdef _WIN32
+    if (base_) UnmapViewOfFile(base_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (base_) munmap(const_cast<uint8_t*>(base_), size_);
+#endif
+    base_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bytes of one resource file. Stored archive entries are views into the mapped archive; compressed
+// entries and loose files own their buffer.
+class ArchiveFile final
+{
+public:
+    [[nodiscard]] const uint8_t* Data() const { return owned_.empty() ? mapped_.data() : owned_.data(); }
+    [[nodiscard]] size_t Size() const { return owned_.empty() ? mapped_.size() : owned_.size(); }
+
+private:
+    friend class ResourceArchive;
+
+    std::span<const uint8_t> mapped_;
+    std::vector<uint8_t> owned_;
+};
+
+// Read-only pack of everything under resources/, produced by scripts/pack_resources.py. The archive is
+// memory-mapped once; lookups binary-search a name-sorted index. Files missing from the archive (or every
+// file when no archive is present) are read from disk, so loose resources keep working during development.
+class ResourceArchive final
+{
+public:
+    static bool Open(const std::string& archivePath, const std::string& rootPath);
+    static void Close();
+    static bool IsOpen();
+
+    // Accepts absolute paths or paths relative to the executable directory.
+    static bool Read(const std::string& path, ArchiveFile& outFile);
+    // Uncompressed size in bytes, or 0 when the file does not exist.
+    static uint64_t GetFileSize(const std::string& path);
+
+private:
+    struct Entry
+    {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t flags;
+        uint32_t reserved;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t storedSize;
+    };
+
+    static const Entry* FindEntry(const std::filesystem::path& path);
+    static bool ReadFromArchive(const std::filesystem::path& path, ArchiveFile& outFile);
+    static bool ReadLooseFile(const std::filesystem::path& path, ArchiveFile& outFile);
+    static std::filesystem::path ResolvePath(const std::string& path);
+    static std::string GetEntryName(const std::filesystem::path& path);
+    static std::string_view GetName(const Entry& entry);
+    static bool Map(const std::filesystem::path& path);
+    static void Unmap();
+
+    static const uint8_t* base_;
+    static size_t size_;
+    static std::span<const Entry> entries_;
+    static std::string_view names_;
+    static std::filesystem::path rootPath_;
+#ifdef _WIN32
+    static void* file_;
+    static void* mapping_;
+#endif
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// Stable reference to a registered resource. A handle stays cheap to dereference for the lifetime of the slot
+// it points at; once the id is re-registered the generation no longer matches and the handle resolves to null.
+struct ResourceHandle
+{
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    uint32_t index = kInvalidIndex;
+    uint32_t generation = 0;
+
+    [[nodiscard]] bool IsValid() const { return index != kInvalidIndex && generation != 0; }
+
+    bool operator==(const ResourceHandle&) const = default;
+};
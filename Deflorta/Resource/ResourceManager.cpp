@@ -1,29 +1,50 @@
 #include "ResourceManager.hpp"
 
 #include "AudioManager.hpp"
+#include "LoadQueue.hpp"
+#include "ResourceArchive.hpp"
+#include "../Base/ThreadPool.hpp"
+#include "../Render/GlobalAtlas.hpp"
+#include "../Render/Renderer.hpp"
 #include "../Utils.hpp"
 
+#include <emmintrin.h>
 #include <pugixml.hpp>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 
 #include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <ranges>
 #include <vector>
 
 IRenderBackend* ResourceManager::backend_ = nullptr;
+bool ResourceManager::generateMips_ = false;
 std::unordered_map<std::string, ResourceGroup> ResourceManager::groups_;
-std::unordered_map<std::string, std::shared_ptr<ITexture>> ResourceManager::images_;
+std::unordered_map<std::string, ResourceHandle> ResourceManager::images_;
+std::array<std::atomic<ResourceManager::ImageSlot*>, ResourceManager::kMaxImageChunks> ResourceManager::imageChunks_{};
+std::vector<std::unique_ptr<ResourceManager::ImageSlot[]>> ResourceManager::imageChunkStorage_;
+uint32_t ResourceManager::imageSlotCount_ = 0;
+uint32_t ResourceManager::imageGeneration_ = 0;
 std::unordered_map<std::string, std::wstring> ResourceManager::fonts_;
 std::string ResourceManager::resourceBasePath_;
 DefaultSettings ResourceManager::currentDefaults;
 std::mutex ResourceManager::groupsMutex_;
+std::unordered_set<std::string> ResourceManager::imagesInFlight_;
+std::condition_variable ResourceManager::imageLoaded_;
+std::unordered_set<std::string> ResourceManager::imagesQueued_;
 
 void ResourceManager::SetRenderBackend(IRenderBackend* backend)
 {
     backend_ = backend;
+    GlobalAtlas::SetRenderBackend(backend);
+}
+
+void ResourceManager::SetGenerateMips(bool enabled)
+{
+    generateMips_ = enabled;
 }
 
 bool ResourceManager::LoadFont(const std::string& id, const std::string& filePath, const std::wstring& familyName)
@@ -54,78 +75,47 @@ std::wstring ResourceManager::GetFont(const std::string& id)
 
 bool ResourceManager::PreloadReanimImage(const std::string& id)
 {
+    std::string groupName;
+    GroupItem item{.kind = ResourceKind::Image, .id = id};
     {
         std::lock_guard lock(groupsMutex_);
-        for (auto& group : groups_ | std::views::values)
+        const ResourceEntry* entry = nullptr;
+        for (auto& [name, group] : groups_)
         {
-            if (auto it = group.images.find(id); it != group.images.end())
+            if (const auto it = group.images.find(id); it != group.images.end())
             {
-                if (!it->second.loaded)
-                {
-                    const std::string fullPath = (std::filesystem::path(resourceBasePath_) / it->second.path).string() +
-                        ".png";
-                    PixelData pixelData;
-                    if (LoadPngFile(fullPath, pixelData))
-                    {
-                        std::shared_ptr<ITexture> texture;
-                        if (CreateTexture(pixelData, &texture))
-                        {
-                            images_[id] = texture;
-                            it->second.loaded = true;
-                        }
-                        else
-                        {
-                            std::cout << "Error: Failed to create texture for reanim image '" << id << "'\n";
-                        }
-                    }
-                    else
-                    {
-                        std::cout << "Error: Failed to load PNG file '" << fullPath << "' for reanim image '" << id <<
-                            "'\n";
-                    }
-                }
-                return images_.contains(id);
+                groupName = name;
+                entry = &it->second;
+                break;
             }
         }
-    }
 
-    {
-        std::lock_guard lock(groupsMutex_);
-        auto& group = groups_["PreloadReanim"];
-        auto& entry = group.images[id];
-        if (!entry.loaded)
+        if (!entry)
         {
-            const std::string fileNameNoExt = TokenToReanimFileName(id);
-            entry.path = (std::filesystem::path("reanim") / fileNameNoExt).string();
-
-            const std::string fullPath = (std::filesystem::path(resourceBasePath_) / entry.path).string() + ".png";
-            PixelData pixelData;
-            if (LoadPngFile(fullPath, pixelData))
-            {
-                std::shared_ptr<ITexture> texture;
-                if (CreateTexture(pixelData, &texture))
-                {
-                    images_[id] = texture;
-                    entry.loaded = true;
-                }
-                else
-                {
-                    std::cout << "Error: Failed to create texture for reanim image '" << id << "'\n";
-                }
-            }
-            else
-            {
-                std::cout << "Error: Failed to load PNG file '" << fullPath << "' for reanim image '" << id << "'\n";
-            }
+            groupName = "PreloadReanim";
+            auto& created = groups_[groupName].images[id];
+            created.path = (std::filesystem::path("reanim") / TokenToReanimFileName(id)).string();
+            entry = &created;
         }
-        return images_.contains(id);
+
+        if (entry->loaded) return images_.contains(id);
+        item.path = (std::filesystem::path(resourceBasePath_) / entry->path).string() + ".png";
     }
+
+    LoadImageNow(groupName, item);
+
+    std::lock_guard lock(groupsMutex_);
+    return images_.contains(id);
 }
 
 bool ResourceManager::LoadPngFile(const std::string& filePath, PixelData& outData)
 {
+    ArchiveFile file;
     int width, height, channels;
-    unsigned char* data = stbi_load(filePath.c_str(), &width, &height, &channels, 4);
+    unsigned char* data = ResourceArchive::Read(filePath, file)
+                              ? stbi_load_from_memory(file.Data(), static_cast<int>(file.Size()), &width, &height,
+                                                      &channels, 4)
+                              : nullptr;
 
     if (!data)
     {
@@ -161,7 +151,13 @@ bool ResourceManager::LoadPngFile(const std::string& filePath, PixelData& outDat
     return true;
 }
 
-bool ResourceManager::CreateTexture(const PixelData& data, std::shared_ptr<ITexture>* outTexture)
+bool ResourceManager::CreateTexture(const PixelData& data, std::shared_ptr<ITexture>* outTexture, bool withMips)
+{
+    return CreateTexture(data, outTexture, withMips ? BuildMips(data) : std::vector<PixelData>{});
+}
+
+bool ResourceManager::CreateTexture(const PixelData& data, std::shared_ptr<ITexture>* outTexture,
+                                    const std::vector<PixelData>& mips)
 {
     if (!backend_)
     {
@@ -174,15 +170,177 @@ bool ResourceManager::CreateTexture(const PixelData& data, std::shared_ptr<IText
     RenderBackendLock lock(backend_);
 
     *outTexture = backend_->CreateTexture(data);
-    return *outTexture != nullptr;
+    if (!*outTexture) return false;
+
+    for (size_t i = 0; i < mips.size(); ++i)
+        (*outTexture)->SetMip(static_cast<int>(i) + 1, backend_->CreateTexture(mips[i]));
+    return true;
+}
+
+std::vector<PixelData> ResourceManager::BuildMips(const PixelData& data)
+{
+    std::vector<PixelData> mips;
+    if (!generateMips_) return mips;
+
+    mips.reserve(ITexture::kMaxMipLevel);
+    // Each level needs at least 16px on both sides to be worth keeping.
+    const PixelData* previous = &data;
+    for (int level = 1; level <= ITexture::kMaxMipLevel; ++level)
+    {
+        if (previous->width < 32 || previous->height < 32) break;
+        mips.push_back(DownsampleHalf(*previous));
+        previous = &mips.back();
+    }
+    return mips;
+}
+
+bool ResourceManager::CreateImageTexture(const std::string& id, const PixelData& data,
+                                         const std::vector<PixelData>& mips, std::shared_ptr<ITexture>* outTexture)
+{
+    if (!backend_ || !outTexture) return false;
+
+    // Images packed into the global atlas keep no full-size texture of their own, only their mips.
+    if (auto entry = GlobalAtlas::Add(id, data))
+    {
+        *outTexture = std::make_shared<AtlasTexture>(std::move(entry));
+
+        RenderBackendLock lock(backend_);
+        for (size_t i = 0; i < mips.size(); ++i)
+            (*outTexture)->SetMip(static_cast<int>(i) + 1, backend_->CreateTexture(mips[i]));
+    }
+    else if (!CreateTexture(data, outTexture, mips))
+    {
+        return false;
+    }
+
+    (*outTexture)->SetName(id);
+    return true;
+}
+
+bool ResourceManager::PublishImage(const std::string& id, const std::shared_ptr<ITexture>& texture)
+{
+    const uint32_t index = imageSlotCount_;
+    const uint32_t chunk = index >> kImageChunkShift;
+    if (chunk >= kMaxImageChunks)
+    {
+        std::cout << "Error: Image table is full, cannot register '" << id << "'\n";
+        return false;
+    }
+
+    ImageSlot* slots = imageChunks_[chunk].load(std::memory_order_relaxed);
+    if (!slots)
+    {
+        imageChunkStorage_.push_back(std::make_unique<ImageSlot[]>(kImageChunkSize));
+        slots = imageChunkStorage_.back().get();
+        imageChunks_[chunk].store(slots, std::memory_order_release);
+    }
+
+    // Readers may still hold the old slot's texture, so a re-registered id retires its slot instead of
+    // overwriting it; the stale generation makes old handles resolve to null.
+    if (const auto found = images_.find(id); found != images_.end())
+    {
+        const ResourceHandle old = found->second;
+        imageChunks_[old.index >> kImageChunkShift].load(std::memory_order_relaxed)
+            [old.index & (kImageChunkSize - 1)].generation.store(0, std::memory_order_release);
+    }
+
+    ImageSlot& slot = slots[index & (kImageChunkSize - 1)];
+    slot.texture = texture;
+    const uint32_t generation = ++imageGeneration_;
+    slot.generation.store(generation, std::memory_order_release);
+
+    ++imageSlotCount_;
+    images_[id] = {index, generation};
+    return true;
+}
+
+ResourceHandle ResourceManager::GetImageHandle(const std::string& id)
+{
+    if (!GetImage(id)) return {};
+
+    std::lock_guard lock(groupsMutex_);
+    const auto found = images_.find(id);
+    return found != images_.end() ? found->second : ResourceHandle{};
+}
+
+const std::shared_ptr<ITexture>& ResourceManager::ResolveImage(ResourceHandle handle)
+{
+    static const std::shared_ptr<ITexture> none;
+    if (!handle.IsValid()) return none;
+
+    const uint32_t chunk = handle.index >> kImageChunkShift;
+    if (chunk >= kMaxImageChunks) return none;
+
+    const ImageSlot* slots = imageChunks_[chunk].load(std::memory_order_acquire);
+    if (!slots) return none;
+
+    const ImageSlot& slot = slots[handle.index & (kImageChunkSize - 1)];
+    if (slot.generation.load(std::memory_order_acquire) != handle.generation) return none;
+    return slot.texture;
+}
+
+PixelData ResourceManager::DownsampleHalf(const PixelData& source)
+{
+    const uint32_t srcPitch = source.pitch ? source.pitch : source.width * 4;
+
+    PixelData result;
+    result.width = (source.width + 1) / 2;
+    result.height = (source.height + 1) / 2;
+    result.pitch = result.width * 4;
+    result.pixels.resize(static_cast<size_t>(result.pitch) * result.height);
+
+    // 2x2 box filter on premultiplied RGBA. Odd edges reuse the last row/column.
+    for (uint32_t y = 0; y < result.height; ++y)
+    {
+        const auto* row0 = reinterpret_cast<const uint32_t*>(source.pixels.data() + static_cast<size_t>(y * 2) *
+            srcPitch);
+        const auto* row1 = reinterpret_cast<const uint32_t*>(source.pixels.data() +
+            static_cast<size_t>(std::min(y * 2 + 1, source.height - 1)) * srcPitch);
+        auto* out = reinterpret_cast<uint32_t*>(result.pixels.data() + static_cast<size_t>(y) * result.pitch);
+
+        uint32_t x = 0;
+        for (; x + 4 <= source.width / 2; x += 4)
+        {
+            const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 2));
+            const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 2 + 4));
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 2));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 2 + 4));
+
+            const __m128 lo = _mm_castsi128_ps(_mm_avg_epu8(a0, b0));
+            const __m128 hi = _mm_castsi128_ps(_mm_avg_epu8(a1, b1));
+            const __m128i even = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m128i odd = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_avg_epu8(even, odd));
+        }
+
+        for (; x < result.width; ++x)
+        {
+            const uint32_t x0 = x * 2;
+            const uint32_t x1 = std::min(x0 + 1, source.width - 1);
+            const __m128i top = _mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(row0[x0])),
+                                                   _mm_cvtsi32_si128(static_cast<int>(row0[x1])));
+            const __m128i bottom = _mm_unpacklo_epi32(_mm_cvtsi32_si128(static_cast<int>(row1[x0])),
+                                                      _mm_cvtsi32_si128(static_cast<int>(row1[x1])));
+            const __m128i vertical = _mm_avg_epu8(top, bottom);
+            out[x] = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_avg_epu8(vertical, _mm_srli_si128(vertical, 4))));
+        }
+    }
+
+    return result;
 }
 
 bool ResourceManager::LoadManifest()
 {
     const std::string exeDir = Utils::GetExecutableDir();
+    ResourceArchive::Open((std::filesystem::path(exeDir) / "resources.pak").string(),
+                          (std::filesystem::path(exeDir) / "resources").string());
+
     std::string manifestPath = (std::filesystem::path(exeDir) / "resources" / "resources.xml").string();
+    ArchiveFile manifestFile;
     pugi::xml_document doc;
-    if (!doc.load_file(manifestPath.c_str()))
+    if (!ResourceArchive::Read(manifestPath, manifestFile) ||
+        !doc.load_buffer(manifestFile.Data(), manifestFile.Size()))
     {
         std::cout << "Error: Failed to load manifest file: " << manifestPath << "\n";
         return false;
@@ -262,6 +420,40 @@ bool ResourceManager::LoadManifest()
 
 bool ResourceManager::LoadGroup(const std::string& groupName)
 {
+    {
+        std::lock_guard lock(groupsMutex_);
+        if (const auto itFind = groups_.find(groupName); itFind != groups_.end() && itFind->second.isLoaded)
+            return true;
+    }
+
+    std::vector<GroupItem> items;
+    if (!GetPendingItems(groupName, items)) return false;
+
+    std::vector<GroupItem> images;
+    for (const auto& item : items)
+    {
+        if (item.kind == ResourceKind::Sound)
+            LoadSoundItem(groupName, item);
+        else if (item.kind == ResourceKind::Image)
+            images.push_back(item);
+    }
+
+    LoadImageItems(groupName, images);
+
+    for (const auto& item : items)
+    {
+        if (item.kind == ResourceKind::Font)
+            LoadFontItem(groupName, item);
+    }
+
+    std::lock_guard lock(groupsMutex_);
+    groups_[groupName].isLoaded = true;
+    return true;
+}
+
+bool ResourceManager::GetPendingItems(const std::string& groupName, std::vector<GroupItem>& outItems)
+{
+    const size_t first = outItems.size();
     {
         std::lock_guard lock(groupsMutex_);
         const auto itFind = groups_.find(groupName);
@@ -270,106 +462,207 @@ bool ResourceManager::LoadGroup(const std::string& groupName)
             std::cout << "Error: Resource group '" << groupName << "' not found in manifest\n";
             return false;
         }
-        if (itFind->second.isLoaded) return true;
+
+        const auto& group = itFind->second;
+        const std::filesystem::path basePath(resourceBasePath_);
+        for (const auto& [id, entry] : group.sounds)
+        {
+            if (!entry.loaded)
+                outItems.push_back({.kind = ResourceKind::Sound, .id = id, .path = (basePath / entry.path).string()});
+        }
+        for (const auto& [id, entry] : group.images)
+        {
+            if (!entry.loaded)
+                outItems.push_back({
+                    .kind = ResourceKind::Image, .id = id, .path = (basePath / entry.path).string() + ".png"
+                });
+        }
+        for (const auto& [id, entry] : group.fonts)
+        {
+            if (!entry.loaded)
+                outItems.push_back({
+                    .kind = ResourceKind::Font, .id = id, .path = (basePath / entry.path).string() + ".ttf"
+                });
+        }
     }
 
+    for (size_t i = first; i < outItems.size(); ++i)
+        outItems[i].bytes = ResourceArchive::GetFileSize(outItems[i].path);
+    return true;
+}
+
+bool ResourceManager::LoadItem(const std::string& groupName, const GroupItem& item)
+{
+    switch (item.kind)
+    {
+    case ResourceKind::Sound:
+        return LoadSoundItem(groupName, item);
+    case ResourceKind::Image:
+        return LoadImageItems(groupName, {&item, 1});
+    case ResourceKind::Font:
+        return LoadFontItem(groupName, item);
+    }
+    return false;
+}
+
+bool ResourceManager::LoadSoundItem(const std::string& groupName, const GroupItem& item)
+{
+    {
+        std::lock_guard lock(groupsMutex_);
+        if (groups_[groupName].sounds[item.id].loaded) return true;
+    }
+
+    // Vorbis decoding is slow, so it runs without the group lock.
+    if (!AudioManager::PreloadAudio(item.id, item.path))
+    {
+        std::cout << "Error: Failed to load audio '" << item.id << "' from path: " << item.path << "\n";
+        return false;
+    }
+
+    std::lock_guard lock(groupsMutex_);
+    groups_[groupName].sounds[item.id].loaded = true;
+    return true;
+}
+
+bool ResourceManager::LoadImageItems(const std::string& groupName, std::span<const GroupItem> items)
+{
+    struct PendingImage
+    {
+        const GroupItem* item = nullptr;
+        int rows = 1;
+        int cols = 1;
+        bool decoded = false;
+        bool loaded = false;
+        PixelData pixels;
+        std::vector<PixelData> mips;
+        std::vector<std::pair<std::string, std::shared_ptr<ITexture>>> textures;
+
+        [[nodiscard]] bool IsSliced() const { return rows > 1 || cols > 1; }
+    };
+
+    std::vector<PendingImage> pending;
+    std::vector<std::string> inFlight;
     {
         std::lock_guard lock(groupsMutex_);
         auto& group = groups_[groupName];
-        for (auto& [id, entry] : group.sounds)
+        for (const auto& item : items)
         {
-            if (!entry.loaded)
+            const auto& entry = group.images[item.id];
+            if (entry.loaded) continue;
+            if (!imagesInFlight_.insert(groupName + "/" + item.id).second)
             {
-                std::string fullPath = (std::filesystem::path(resourceBasePath_) / entry.path).string();
-                if (AudioManager::PreloadAudio(id, fullPath))
-                {
-                    entry.loaded = true;
-                }
-                else
-                {
-                    std::cout << "Error: Failed to load audio '" << id << "' from path: " << fullPath << "\n";
-                }
+                inFlight.push_back(item.id);
+                continue;
             }
+            pending.push_back({.item = &item, .rows = entry.rows, .cols = entry.cols});
         }
     }
 
+    // Decoding dominates load time, so it fans out across the pool without holding the group lock.
+    ThreadPool::Shared().ParallelFor(pending.size(), [&pending](size_t i)
     {
-        std::lock_guard lock(groupsMutex_);
-        auto& group = groups_[groupName];
-        for (auto& [id, entry] : group.images)
+        auto& image = pending[i];
+        image.decoded = LoadPngFile(image.item->path, image.pixels);
+        if (image.decoded && !image.IsSliced())
+            image.mips = BuildMips(image.pixels);
+    });
+
+    // Texture creation runs on the thread that owns the backend without the group lock, which is only taken to
+    // publish the finished textures.
+    std::vector<std::function<void()>> uploads;
+    for (auto& image : pending)
+    {
+        if (!image.decoded)
         {
-            if (!entry.loaded)
+            std::cout << "Error: Failed to load PNG file for image '" << image.item->id << "' from path: "
+                << image.item->path << "\n";
+            continue;
+        }
+
+        uploads.emplace_back([&image]
+        {
+            const std::string& id = image.item->id;
+            if (image.IsSliced())
             {
-                std::string fullPath = (std::filesystem::path(resourceBasePath_) / entry.path).string() + ".png";
-                if (PixelData pixelData; LoadPngFile(fullPath, pixelData))
+                if (!CreateSlicedImages(id, image.pixels, image.rows, image.cols, image.textures))
                 {
-                    if (entry.rows > 1 || entry.cols > 1)
-                    {
-                        if (CreateSlicedImages(id, pixelData, entry.rows, entry.cols))
-                        {
-                            entry.loaded = true;
-                        }
-                        else
-                        {
-                            std::cout << "Error: Failed to slice image '" << id << "'\n";
-                        }
-                    }
-                    else
-                    {
-                        std::shared_ptr<ITexture> texture;
-                        if (CreateTexture(pixelData, &texture))
-                        {
-                            images_[id] = texture;
-                            entry.loaded = true;
-                        }
-                        else
-                        {
-                            std::cout << "Error: Failed to create texture for image '" << id << "'\n";
-                        }
-                    }
-                }
-                else
-                {
-                    std::cout << "Error: Failed to load PNG file for image '" << id << "' from path: " << fullPath <<
-                        "\n";
+                    std::cout << "Error: Failed to slice image '" << id << "'\n";
+                    image.textures.clear();
                 }
+                return;
             }
-        }
+
+            std::shared_ptr<ITexture> texture;
+            if (CreateImageTexture(id, image.pixels, image.mips, &texture))
+            {
+                image.textures.emplace_back(id, std::move(texture));
+            }
+            else
+            {
+                std::cout << "Error: Failed to create texture for image '" << id << "'\n";
+            }
+        });
     }
+    Renderer::RunOnBackendThread(std::move(uploads));
 
     {
         std::lock_guard lock(groupsMutex_);
         auto& group = groups_[groupName];
-        for (auto& [id, entry] : group.fonts)
+        for (auto& image : pending)
         {
-            if (!entry.loaded)
-            {
-                std::string fullPath = (std::filesystem::path(resourceBasePath_) / entry.path).string() + ".ttf";
-                if (LoadFont(id, fullPath, entry.fontFamily))
-                {
-                    entry.loaded = true;
-                }
-                else
-                {
-                    std::cout << "Error: Failed to load font '" << id << "' from path: " << fullPath << "\n";
-                }
-            }
+            imagesInFlight_.erase(groupName + "/" + image.item->id);
+            if (image.textures.empty()) continue;
+
+            bool published = true;
+            for (const auto& [id, texture] : image.textures)
+                published = PublishImage(id, texture) && published;
+            group.images[image.item->id].loaded = image.loaded = published;
         }
+    }
+    imageLoaded_.notify_all();
+
+    const bool loaded = std::ranges::all_of(pending, &PendingImage::loaded);
+    return WaitForImages(groupName, inFlight) && loaded;
+}
 
-        group.isLoaded = true;
+bool ResourceManager::WaitForImages(const std::string& groupName, const std::vector<std::string>& ids)
+{
+    bool loaded = true;
+    std::unique_lock lock(groupsMutex_);
+    for (const auto& id : ids)
+    {
+        const std::string key = groupName + "/" + id;
+        while (imagesInFlight_.contains(key))
+        {
+            // The other load may be waiting for this thread to run its texture uploads.
+            lock.unlock();
+            Renderer::PumpBackendTasks();
+            lock.lock();
+            imageLoaded_.wait_for(lock, std::chrono::milliseconds(1),
+                                  [&key] { return !imagesInFlight_.contains(key); });
+        }
+        loaded = groups_[groupName].images[id].loaded && loaded;
     }
-    return true;
+    return loaded;
 }
 
-std::shared_ptr<ITexture> ResourceManager::GetImage(const std::string& id)
+bool ResourceManager::LoadFontItem(const std::string& groupName, const GroupItem& item)
 {
     std::lock_guard lock(groupsMutex_);
+    auto& entry = groups_[groupName].fonts[item.id];
+    if (entry.loaded) return true;
 
-    if (const auto found = images_.find(id); found != images_.end())
+    if (!LoadFont(item.id, item.path, entry.fontFamily))
     {
-        return found->second;
+        std::cout << "Error: Failed to load font '" << item.id << "' from path: " << item.path << "\n";
+        return false;
     }
+    entry.loaded = true;
+    return true;
+}
 
+std::shared_ptr<ITexture> ResourceManager::GetImage(const std::string& id)
+{
     std::string baseId = id;
     const size_t lastUnderscore = id.find_last_of('_');
     if (lastUnderscore != std::string::npos)
@@ -381,61 +674,83 @@ std::shared_ptr<ITexture> ResourceManager::GetImage(const std::string& id)
         }
     }
 
-    for (auto& group : groups_ | std::views::values)
+    std::string groupName;
+    GroupItem item{.kind = ResourceKind::Image, .id = baseId};
     {
-        if (auto it = group.images.find(baseId); it != group.images.end())
+        std::lock_guard lock(groupsMutex_);
+        if (const auto found = images_.find(id); found != images_.end())
         {
-            if (!it->second.loaded)
-            {
-                const std::string fullPath = (std::filesystem::path(resourceBasePath_) / it->second.path).string() +
-                    ".png";
-                PixelData pixelData;
-                if (LoadPngFile(fullPath, pixelData))
-                {
-                    if (it->second.rows > 1 || it->second.cols > 1)
-                    {
-                        if (CreateSlicedImages(baseId, pixelData, it->second.rows, it->second.cols))
-                        {
-                            it->second.loaded = true;
-                        }
-                        else
-                        {
-                            std::cout << "Error: Failed to slice image '" << baseId << "'\n";
-                        }
-                    }
-                    else
-                    {
-                        std::shared_ptr<ITexture> texture;
-                        if (CreateTexture(pixelData, &texture))
-                        {
-                            images_[baseId] = texture;
-                            it->second.loaded = true;
-                        }
-                        else
-                        {
-                            std::cout << "Error: Failed to create texture for image '" << baseId << "'\n";
-                        }
-                    }
-                }
-                else
-                {
-                    std::cout << "Error: Failed to load PNG file for image '" << baseId << "' from path: " << fullPath
-                        <<
-                        "\n";
-                }
-            }
+            if (!imagesQueued_.empty()) imagesQueued_.erase(id);
+            return ResolveImage(found->second);
+        }
 
-            const auto found = images_.find(id);
-            if (found == images_.end())
+        for (auto& [name, group] : groups_)
+        {
+            if (const auto it = group.images.find(baseId); it != group.images.end())
             {
-                std::cout << "Error: Image '" << id << "' not found in loaded images after load attempt\n";
-                return nullptr;
+                groupName = name;
+                item.path = (std::filesystem::path(resourceBasePath_) / it->second.path).string() + ".png";
+                break;
             }
-            return found->second;
         }
     }
-    std::cout << "Error: Image '" << id << "' not found in any resource group\n";
-    return nullptr;
+
+    if (groupName.empty())
+    {
+        std::cout << "Error: Image '" << id << "' not found in any resource group\n";
+        return nullptr;
+    }
+
+    // Scene workers render while the backend thread waits on them, so they cannot wait for the upload.
+    if (ThreadPool::IsWorkerThread())
+    {
+        QueueImage(id, groupName, item);
+        return nullptr;
+    }
+
+    LoadImageNow(groupName, item);
+
+    std::lock_guard lock(groupsMutex_);
+    const auto found = images_.find(id);
+    if (found == images_.end())
+    {
+        std::cout << "Error: Image '" << id << "' not found in loaded images after load attempt\n";
+        return nullptr;
+    }
+    return ResolveImage(found->second);
+}
+
+void ResourceManager::LoadImageNow(const std::string& groupName, const GroupItem& item)
+{
+    // Loads through the queue like any group file: this thread decodes it without the group lock and
+    // the texture goes through the backend upload path.
+    const LoadTicket ticket = LoadQueue::CreateTicket();
+    LoadQueue::EnqueueTask(ticket, [groupName, item] { return LoadItem(groupName, item); }, LoadPriority::Immediate);
+    LoadQueue::Wait(ticket);
+    LoadQueue::Release(ticket);
+}
+
+void ResourceManager::QueueImage(const std::string& id, const std::string& groupName, const GroupItem& item)
+{
+    {
+        std::lock_guard lock(groupsMutex_);
+        if (!imagesQueued_.insert(id).second) return;
+    }
+
+    LoadQueue::EnqueueTask(0, [id, groupName, item]
+    {
+        if (LoadItem(groupName, item)) return true;
+
+        std::lock_guard lock(groupsMutex_);
+        imagesQueued_.erase(id);
+        return false;
+    }, LoadPriority::Immediate);
+}
+
+bool ResourceManager::IsImageQueued(const std::string& id)
+{
+    std::lock_guard lock(groupsMutex_);
+    return imagesQueued_.contains(id);
 }
 
 void ResourceManager::PreloadAudio(const std::string& id)
@@ -500,7 +815,8 @@ std::string ResourceManager::TokenToReanimFileName(const std::string& id)
     return result;
 }
 
-bool ResourceManager::CreateSlicedImages(const std::string& baseId, const PixelData& sourceData, int rows, int cols)
+bool ResourceManager::CreateSlicedImages(const std::string& baseId, const PixelData& sourceData, int rows, int cols,
+                                         std::vector<std::pair<std::string, std::shared_ptr<ITexture>>>& outTiles)
 {
     if (rows <= 0 || cols <= 0)
     {
@@ -540,11 +856,11 @@ bool ResourceManager::CreateSlicedImages(const std::string& baseId, const PixelD
                 );
             }
 
+            std::string tileId = baseId + "_" + std::to_string(index);
             std::shared_ptr<ITexture> texture;
-            if (CreateTexture(tileData, &texture))
+            if (CreateImageTexture(tileId, tileData, BuildMips(tileData), &texture))
             {
-                const std::string slicedId = baseId + "_" + std::to_string(index);
-                images_[slicedId] = texture;
+                outTiles.emplace_back(std::move(tileId), std::move(texture));
             }
             else
             {
@@ -560,6 +876,11 @@ bool ResourceManager::CreateSlicedImages(const std::string& baseId, const PixelD
 }
 
 bool ResourceManager::LoadReanimImageData(const std::string& id, PixelData& outData)
+{
+    return LoadPngFile(GetReanimImagePath(id), outData);
+}
+
+std::string ResourceManager::GetReanimImagePath(const std::string& id)
 {
     {
         std::lock_guard lock(groupsMutex_);
@@ -567,18 +888,14 @@ bool ResourceManager::LoadReanimImageData(const std::string& id, PixelData& outD
         {
             if (auto it = group.images.find(id); it != group.images.end())
             {
-                const std::string fullPath = (std::filesystem::path(resourceBasePath_) / it->second.path).string() +
-                    ".png";
-                return LoadPngFile(fullPath, outData);
+                return (std::filesystem::path(resourceBasePath_) / it->second.path).string() + ".png";
             }
         }
     }
 
     const std::string fileNameNoExt = TokenToReanimFileName(id);
     const std::string reanimPath = (std::filesystem::path("reanim") / fileNameNoExt).string();
-    const std::string fullPath = (std::filesystem::path(resourceBasePath_) / reanimPath).string() + ".png";
-
-    return LoadPngFile(fullPath, outData);
+    return (std::filesystem::path(resourceBasePath_) / reanimPath).string() + ".png";
 }
 
 std::shared_ptr<ITexture> ResourceManager::CreateTextureFromPixelData(const PixelData& data)
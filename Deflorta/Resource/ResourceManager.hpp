@@ -1,12 +1,19 @@
 #pragma once
 
+#include "ResourceHandle.hpp"
 #include "../Render/IRenderBackend.hpp"
 #include "../Render/PixelData.hpp"
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <memory>
+#include <span>
+#include <vector>
 
 struct ResourceEntry
 {
@@ -29,6 +36,22 @@ struct DefaultSettings
     std::string idPrefix;
 };
 
+enum class ResourceKind : std::uint8_t
+{
+    Sound,
+    Image,
+    Font
+};
+
+// One unloaded file of a group, with its resolved path and size for progress reporting.
+struct GroupItem
+{
+    ResourceKind kind = ResourceKind::Image;
+    std::string id;
+    std::string path;
+    uint64_t bytes = 0;
+};
+
 struct ResourceGroup
 {
     std::unordered_map<std::string, ResourceEntry> sounds;
@@ -41,33 +64,75 @@ class ResourceManager final
 {
 public:
     static void SetRenderBackend(IRenderBackend* backend);
+    static void SetGenerateMips(bool enabled);
 
     static bool LoadManifest();
     static bool LoadGroup(const std::string& groupName);
+    static bool GetPendingItems(const std::string& groupName, std::vector<GroupItem>& outItems);
+    static bool LoadItem(const std::string& groupName, const GroupItem& item);
 
+    // On a thread pool worker a miss is queued instead of waited for, and null is returned until it loads.
     static std::shared_ptr<ITexture> GetImage(const std::string& id);
+    static bool IsImageQueued(const std::string& id);
+    static ResourceHandle GetImageHandle(const std::string& id);
+    static const std::shared_ptr<ITexture>& ResolveImage(ResourceHandle handle);
     static std::wstring GetFont(const std::string& id);
 
     static void PreloadAudio(const std::string& id);
     static bool PreloadReanimImage(const std::string& id);
 
     static bool LoadReanimImageData(const std::string& id, PixelData& outData);
+    static std::string GetReanimImagePath(const std::string& id);
     static std::shared_ptr<ITexture> CreateTextureFromPixelData(const PixelData& data);
 
 private:
+    struct ImageSlot
+    {
+        std::shared_ptr<ITexture> texture;
+        std::atomic<uint32_t> generation = 0;
+    };
+
+    static constexpr uint32_t kImageChunkShift = 8;
+    static constexpr uint32_t kImageChunkSize = 1u << kImageChunkShift;
+    static constexpr uint32_t kMaxImageChunks = 256;
+
     static bool LoadPngFile(const std::string& filePath, PixelData& outData);
-    static bool CreateTexture(const PixelData& data, std::shared_ptr<ITexture>* outTexture);
+    static bool CreateTexture(const PixelData& data, std::shared_ptr<ITexture>* outTexture, bool withMips = false);
+    static bool CreateTexture(const PixelData& data, std::shared_ptr<ITexture>* outTexture,
+                              const std::vector<PixelData>& mips);
+    static std::vector<PixelData> BuildMips(const PixelData& data);
+    static PixelData DownsampleHalf(const PixelData& source);
+    static bool CreateImageTexture(const std::string& id, const PixelData& data, const std::vector<PixelData>& mips,
+                                   std::shared_ptr<ITexture>* outTexture);
+    static bool PublishImage(const std::string& id, const std::shared_ptr<ITexture>& texture);
+    static bool LoadSoundItem(const std::string& groupName, const GroupItem& item);
+    static bool LoadImageItems(const std::string& groupName, std::span<const GroupItem> items);
+    static void LoadImageNow(const std::string& groupName, const GroupItem& item);
+    static void QueueImage(const std::string& id, const std::string& groupName, const GroupItem& item);
+    static bool WaitForImages(const std::string& groupName, const std::vector<std::string>& ids);
+    static bool LoadFontItem(const std::string& groupName, const GroupItem& item);
     static bool LoadFont(const std::string& id, const std::string& filePath, const std::wstring& familyName);
     static std::string TokenToReanimFileName(const std::string& id);
-    static bool CreateSlicedImages(const std::string& baseId, const PixelData& sourceData, int rows, int cols);
+    static bool CreateSlicedImages(const std::string& baseId, const PixelData& sourceData, int rows, int cols,
+                                   std::vector<std::pair<std::string, std::shared_ptr<ITexture>>>& outTiles);
 
     static IRenderBackend* backend_;
+    static bool generateMips_;
     static std::unordered_map<std::string, ResourceGroup> groups_;
-    static std::unordered_map<std::string, std::shared_ptr<ITexture>> images_;
+    static std::unordered_map<std::string, ResourceHandle> images_;
+    static std::array<std::atomic<ImageSlot*>, kMaxImageChunks> imageChunks_;
+    static std::vector<std::unique_ptr<ImageSlot[]>> imageChunkStorage_;
+    static uint32_t imageSlotCount_;
+    static uint32_t imageGeneration_;
     static std::unordered_map<std::string, std::wstring> fonts_;
 
     static std::string resourceBasePath_;
     static DefaultSettings currentDefaults;
 
     static std::mutex groupsMutex_;
+    // "group/id" of images being decoded, so a second load of the same file waits instead of decoding it again.
+    static std::unordered_set<std::string> imagesInFlight_;
+    static std::condition_variable imageLoaded_;
+    // Ids whose miss was queued from a pool worker; cleared by the first lookup that finds them, or a failed load.
+    static std::unordered_set<std::string> imagesQueued_;
 };
@@ -1,6 +1,7 @@
 ﻿#include "TranslationManager.hpp"
 
-#include <fstream>
+#include "ResourceArchive.hpp"
+
 #include <sstream>
 #include <filesystem>
 
@@ -9,9 +10,10 @@ std::mutex TranslationManager::mutex_;
 
 bool TranslationManager::Load(const std::string& filePath)
 {
-    std::ifstream file(filePath, std::ios::binary);
-    if (!file.is_open())
+    ArchiveFile archiveFile;
+    if (!ResourceArchive::Read(filePath, archiveFile))
         return false;
+    std::istringstream file(std::string(reinterpret_cast<const char*>(archiveFile.Data()), archiveFile.Size()));
 
     std::unordered_map<std::string, std::string> temp;
 
@@ -5,6 +5,7 @@
 #include "../Object/Plant/SunFlower.hpp"
 #include "../Render/Layer.hpp"
 #include "../Render/Renderer.hpp"
+#include "../Resource/LoadQueue.hpp"
 #include "../Resource/ResourceManager.hpp"
 #include "../Base/Random.hpp"
 #include "../Object/Clickable/SpawnAnimation.hpp"
@@ -84,7 +85,12 @@ BoardScene::BoardScene(BoardSettings settings) : settings_(std::move(settings))
     }
 
     if (!loadGroup.empty())
-        ResourceManager::LoadGroup(loadGroup);
+    {
+        const LoadTicket ticket = LoadQueue::CreateTicket();
+        LoadQueue::EnqueueGroup(ticket, loadGroup, LoadPriority::Immediate);
+        LoadQueue::Wait(ticket);
+        LoadQueue::Release(ticket);
+    }
 
     if (!bgName.empty())
         background_ = ResourceManager::GetImage(bgName);
@@ -125,6 +131,17 @@ BoardScene::BoardScene(BoardSettings settings) : settings_(std::move(settings))
         .rotation = 0.0f
     };
 
+    staticLayer_.Record([this]
+    {
+        Renderer::EnqueueImage(background_, backgroundTransform_, 1, static_cast<int>(RenderLayer::Background));
+        if (cover_)
+            Renderer::EnqueueImage(cover_, coverTransform_, 1, static_cast<int>(RenderLayer::Foreground));
+        if (tree_)
+            Renderer::EnqueueImage(tree_, treeTransform_, 1, static_cast<int>(RenderLayer::Foreground));
+        if (pole_)
+            Renderer::EnqueueImage(pole_, poleTransform_, 1, static_cast<int>(RenderLayer::Foreground));
+    });
+
     if (settings_.hasFog)
     {
         fog_ = GameObject::Create<Fog>(rows, settings_.fogColumns);
@@ -176,13 +193,7 @@ void BoardScene::Render()
 {
     Scene::Render();
 
-    Renderer::EnqueueImage(background_, backgroundTransform_, 1, static_cast<int>(RenderLayer::Background));
-    if (cover_)
-        Renderer::EnqueueImage(cover_, coverTransform_, 1, static_cast<int>(RenderLayer::Foreground));
-    if (tree_)
-        Renderer::EnqueueImage(tree_, treeTransform_, 1, static_cast<int>(RenderLayer::Foreground));
-    if (pole_)
-        Renderer::EnqueueImage(pole_, poleTransform_, 1, static_cast<int>(RenderLayer::Foreground));
+    staticLayer_.Render();
 }
 
 glm::vec2 BoardScene::GridToPosition(int row, int column, BackgroundType bgType)
@@ -6,6 +6,7 @@
 #include "../Object/Fog.hpp"
 #include "../Object/Plant/BasePlant.hpp"
 #include "../Object/SeedBank.hpp"
+#include "../Render/StaticLayer.hpp"
 #include "../Base/Timer.hpp"
 
 #include <string>
@@ -67,6 +68,8 @@ private:
     Transform poleTransform_;
     Transform treeTransform_;
 
+    StaticLayer staticLayer_;
+
     std::shared_ptr<Bush> bush_;
     std::shared_ptr<Fog> fog_;
     std::shared_ptr<SeedBank> seedBank_;
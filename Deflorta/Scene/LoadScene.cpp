@@ -5,6 +5,7 @@
 #include "SelectorScene.hpp"
 #include "../Base/Game.hpp"
 #include "../Base/Time.hpp"
+#include "../Resource/ResourceArchive.hpp"
 #include "../Resource/ResourceManager.hpp"
 #include "../Render/Renderer.hpp"
 #include "../Base/Transform.hpp"
@@ -17,20 +18,20 @@
 
 namespace
 {
-    std::atomic_bool g_LoadingDone = false;
+    constexpr auto kStringsPath = "resources/LawnStrings.txt";
+    const Rect kProgressBar = Rect::FromXYWH(440.0f, 640.0f, 400.0f, 12.0f);
 }
 
 LoadScene::LoadScene()
 {
     ResourceManager::LoadGroup("Init");
-    std::thread([]
-    {
-        TranslationManager::Load("resources/LawnStrings.txt");
-        ResourceManager::LoadGroup("LoadingImages");
-        ResourceManager::LoadGroup("LoadingSounds");
-        ResourceManager::LoadGroup("LoadingFonts");
-        g_LoadingDone = true;
-    }).detach();
+
+    loadTicket_ = LoadQueue::CreateTicket();
+    LoadQueue::EnqueueTask(loadTicket_, [] { return TranslationManager::Load(kStringsPath); },
+                           LoadPriority::NextScene, ResourceArchive::GetFileSize(kStringsPath));
+    LoadQueue::EnqueueGroup(loadTicket_, "LoadingImages", LoadPriority::NextScene);
+    LoadQueue::EnqueueGroup(loadTicket_, "LoadingSounds", LoadPriority::NextScene);
+    LoadQueue::EnqueueGroup(loadTicket_, "LoadingFonts", LoadPriority::NextScene);
 
     auto loadCentered = [&](const std::string& name, float centerX, float centerY,
                             float scale = 1.0f) -> std::pair<std::shared_ptr<ITexture>, Transform>
@@ -56,6 +57,11 @@ LoadScene::LoadScene()
     rollCap_ = rollPair.first;
     rollCapTransform_ = rollPair.second;
 
+    screenLayer_.Record([this]
+    {
+        Renderer::EnqueueImage(screen_, screenTransform_, 1.0f, static_cast<int>(RenderLayer::Foreground));
+    });
+
     const std::vector<TweenProperty> props = {
         {
             .start = 0.5f, .end = 1.2f, .setter = [&](float v)
@@ -78,12 +84,15 @@ void LoadScene::OnEnter()
 {
     Discord::SetPresence("Loading", "Starting up");
     Input::SetCursorType(GLFW_NOT_ALLOWED_CURSOR);
+    Renderer::SetPartialRedraw(true);
 }
 
 void LoadScene::OnExit()
 {
+    LoadQueue::Release(loadTicket_);
     AudioManager::PlaySfx("SOUND_ROLL_IN");
     Input::SetCursorType(GLFW_ARROW_CURSOR);
+    Renderer::SetPartialRedraw(false);
 }
 
 void LoadScene::Update()
@@ -93,7 +102,10 @@ void LoadScene::Update()
     startTween_->Update();
     rollCapTransform_.rotation += 90.0f * Time::GetDeltaTime();
 
-    if (g_LoadingDone && !startTween_->IsActive() && !exitTween_)
+    const LoadProgress progress = LoadQueue::GetProgress(loadTicket_);
+    loadFraction_ = std::max(loadFraction_, std::clamp(progress.GetFraction(), 0.0f, 1.0f));
+
+    if (progress.IsComplete() && !startTween_->IsActive() && !exitTween_)
     {
         const std::vector<TweenProperty> hideProps = {
             {
@@ -135,8 +147,15 @@ void LoadScene::Render()
 {
     Scene::Render();
 
-    Renderer::EnqueueImage(screen_, screenTransform_, 1.0f, static_cast<int>(RenderLayer::Foreground));
+    screenLayer_.Render();
     Renderer::EnqueueImage(logo_, logoTransform_, logoOpacity_, static_cast<int>(RenderLayer::UI));
     Renderer::EnqueueImage(pvzLogo_, pvzTransform_, logoOpacity_, static_cast<int>(RenderLayer::UI));
     Renderer::EnqueueImage(rollCap_, rollCapTransform_, logoOpacity_, static_cast<int>(RenderLayer::UI));
+
+    const int barZ = static_cast<int>(RenderLayer::UI);
+    const Rect filled = Rect::FromXYWH(kProgressBar.X(), kProgressBar.Y(), kProgressBar.Width() * loadFraction_,
+                                       kProgressBar.Height());
+    Renderer::EnqueueRectangle(kProgressBar, Color(0.0f, 0.0f, 0.0f, 0.5f * logoOpacity_), 0.0f, true, barZ);
+    Renderer::EnqueueRectangle(filled, Color(0.45f, 0.8f, 0.2f, logoOpacity_), 0.0f, true, barZ);
+    Renderer::EnqueueRectangle(kProgressBar, Color(1.0f, 1.0f, 1.0f, logoOpacity_), 1.0f, false, barZ);
 }
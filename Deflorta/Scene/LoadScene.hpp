@@ -4,6 +4,8 @@
 #include "../Base/Transform.hpp"
 #include "../Base/Tween.hpp"
 #include "../Render/IRenderBackend.hpp"
+#include "../Render/StaticLayer.hpp"
+#include "../Resource/LoadQueue.hpp"
 
 #include <memory>
 
@@ -24,6 +26,9 @@ private:
     Transform rollCapTransform_;
 
     float logoOpacity_ = 0.0f;
+    float loadFraction_ = 0.0f;
+
+    LoadTicket loadTicket_ = 0;
 
     std::unique_ptr<Tween> startTween_;
     std::unique_ptr<Tween> exitTween_;
@@ -32,4 +37,6 @@ private:
     std::shared_ptr<ITexture> logo_;
     std::shared_ptr<ITexture> pvzLogo_;
     std::shared_ptr<ITexture> rollCap_;
+
+    StaticLayer screenLayer_;
 };
@@ -4,9 +4,16 @@
 #include "../Collision/CollisionSystem.hpp"
 #include "../Collision/QuadTree.hpp"
 #include "../UI/Widget.hpp"
+#include "../Base/ThreadPool.hpp"
+#include "../Render/Renderer.hpp"
 
 #include <algorithm>
 
+namespace
+{
+    constexpr size_t kParallelRenderThreshold = 32;
+}
+
 Scene::Scene()
 {
     collisionSystem_ = std::make_unique<CollisionSystem>(Rect::FromXYWH(0, 0, 1280, 720));
@@ -51,11 +58,28 @@ void Scene::Update()
 
 void Scene::Render()
 {
-    for (const auto& gameObject : gameObjects_)
+    if (gameObjects_.size() >= kParallelRenderThreshold)
+    {
+        const auto count = static_cast<uint32_t>(gameObjects_.size());
+        const uint32_t baseKey = Renderer::ReserveSubmitKeys(count);
+        ThreadPool::Shared().ParallelFor(count, [&](size_t i)
+        {
+            const auto& gameObject = gameObjects_[i];
+            if (gameObject && gameObject->IsVisible())
+            {
+                DrawRecordScope scope(baseKey + static_cast<uint32_t>(i));
+                gameObject->Render();
+            }
+        });
+    }
+    else
     {
-        if (gameObject && gameObject->IsVisible())
+        for (const auto& gameObject : gameObjects_)
         {
-            gameObject->Render();
+            if (gameObject && gameObject->IsVisible())
+            {
+                gameObject->Render();
+            }
         }
     }
 
@@ -8,7 +8,9 @@
 #include "../Base/Discord.hpp"
 #include "../Base/Game.hpp"
 #include "../Render/Layer.hpp"
+#include "../Render/Renderer.hpp"
 #include "../Resource/Foley.hpp"
+#include "../Resource/LoadQueue.hpp"
 #include "../Resource/ResourceManager.hpp"
 
 #include <stdexcept>
@@ -196,6 +198,17 @@ SelectorScene::SelectorScene()
 void SelectorScene::OnEnter()
 {
     Discord::SetPresence("Selector: Opening", "Main Menu");
+    Renderer::SetPartialRedraw(true);
+
+    // Adventure starts on the day lawn; stream it while the menu is idle.
+    prefetchTicket_ = LoadQueue::CreateTicket();
+    LoadQueue::EnqueueGroup(prefetchTicket_, "DelayLoad_Background1", LoadPriority::Background);
+}
+
+void SelectorScene::OnExit()
+{
+    LoadQueue::Release(prefetchTicket_);
+    Renderer::SetPartialRedraw(false);
 }
 
 void SelectorScene::Update()
@@ -209,6 +222,7 @@ void SelectorScene::Update()
     if (sceneState_ == SelectorState::Open && screenAnimation_->IsFinished())
     {
         sceneState_ = SelectorState::Idle;
+        screenLayer_.Record([this] { screenAnimation_->Draw(); });
         Discord::SetPresence("Main Menu", "Idle");
         signAnimation_->PlayLayer("anim_sign_idle", ReanimLoopType::Loop, 3.0f, 2.0f);
     }
@@ -223,7 +237,10 @@ void SelectorScene::Update()
 void SelectorScene::Render()
 {
     Scene::Render();
-    screenAnimation_->Draw();
+    if (screenLayer_.IsEmpty())
+        screenAnimation_->Draw();
+    else
+        screenLayer_.Render();
     grassAnimation_->Draw();
     signAnimation_->Draw();
     cloudAnimation_->Draw();
@@ -2,6 +2,8 @@
 
 #include "Scene.hpp"
 #include "../Render/Reanimator.hpp"
+#include "../Render/StaticLayer.hpp"
+#include "../Resource/LoadQueue.hpp"
 #include "../UI/ImageButton.hpp"
 
 #include <cstdint>
@@ -19,6 +21,7 @@ public:
     SelectorScene();
 
     void OnEnter() override;
+    void OnExit() override;
     void Update() override;
     void Render() override;
 
@@ -30,6 +33,8 @@ private:
     std::unique_ptr<Reanimator> signAnimation_;
     std::unique_ptr<Reanimator> cloudAnimation_;
 
+    StaticLayer screenLayer_;
+
     std::unique_ptr<ImageButton> startButton_;
     std::unique_ptr<ImageButton> miniGameButton_;
     std::unique_ptr<ImageButton> puzzleButton_;
@@ -40,4 +45,5 @@ private:
     std::unique_ptr<ImageButton> quitButton_;
 
     bool startPressed_ = false;
+    LoadTicket prefetchTicket_ = 0;
 };
@@ -1,5 +1,7 @@
 #include "Utils.hpp"
 
+#include <bit>
+#include <cstring>
 #include <filesystem>
 
 #ifdef _WIN32
@@ -26,6 +28,89 @@ namespace Utils
         return n;
     }
 
+    namespace
+    {
+        constexpr uint64_t kPrime1 = 0x9e3779b185ebca87ull;
+        constexpr uint64_t kPrime2 = 0xc2b2ae3d27d4eb4full;
+        constexpr uint64_t kPrime3 = 0x165667b19e3779f9ull;
+        constexpr uint64_t kPrime4 = 0x85ebca77c2b2ae63ull;
+        constexpr uint64_t kPrime5 = 0x27d4eb2f165667c5ull;
+
+        uint64_t Read64(const uint8_t* p)
+        {
+            uint64_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint32_t Read32(const uint8_t* p)
+        {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+
+        uint64_t Round(uint64_t acc, uint64_t input)
+        {
+            return std::rotl(acc + input * kPrime2, 31) * kPrime1;
+        }
+
+        uint64_t MergeRound(uint64_t acc, uint64_t value)
+        {
+            return (acc ^ Round(0, value)) * kPrime1 + kPrime4;
+        }
+    }
+
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed)
+    {
+        const auto* p = static_cast<const uint8_t*>(data);
+        const uint8_t* const end = p + size;
+        uint64_t hash;
+
+        if (size >= 32)
+        {
+            uint64_t v1 = seed + kPrime1 + kPrime2;
+            uint64_t v2 = seed + kPrime2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - kPrime1;
+            for (; p + 32 <= end; p += 32)
+            {
+                v1 = Round(v1, Read64(p));
+                v2 = Round(v2, Read64(p + 8));
+                v3 = Round(v3, Read64(p + 16));
+                v4 = Round(v4, Read64(p + 24));
+            }
+            hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) + std::rotl(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + kPrime5;
+        }
+
+        hash += size;
+        for (; p + 8 <= end; p += 8)
+            hash = std::rotl(hash ^ Round(0, Read64(p)), 27) * kPrime1 + kPrime4;
+        if (p + 4 <= end)
+        {
+            hash = std::rotl(hash ^ Read32(p) * kPrime1, 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+        for (; p < end; ++p)
+            hash = std::rotl(hash ^ *p * kPrime5, 11) * kPrime1;
+
+        // Final avalanche so every input bit affects every output bit.
+        hash ^= hash >> 33;
+        hash *= kPrime2;
+        hash ^= hash >> 29;
+        hash *= kPrime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
     std::string GetExecutableDir()
     {
 #ifdef _WIN32
@@ -6,5 +6,7 @@
 namespace Utils
 {
     uint32_t NextPowerOf2(uint32_t n);
+    // XXH64. Chain calls by passing the previous result as the seed.
+    uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
     std::string GetExecutableDir();
 }
@@ -0,0 +1,96 @@
+"""Packs resources/ into a single archive read by ResourceArchive (Deflorta/Resource/ResourceArchive.cpp).
+
+Layout, little-endian:
+    header   magic "DFPK", version, entry count, reserved, index offset, names offset, names size
+    index    one 40-byte entry per file, sorted by name:
+             name offset, name length, flags, reserved, data offset, size, stored size
+    names    lower-case paths relative to resources/, '/'-separated, not terminated
+    data     file contents, each starting on a 16-byte boundary
+
+Text formats are zlib-compressed when that saves at least 10%; PNG and OGG are already compressed and are
+stored as-is so the game can read them straight out of the mapping.
+
+Usage: pack_resources.py <resources dir> <output archive>
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"DFPK"
+VERSION = 1  # Must match kArchiveVersion in ResourceArchive.cpp.
+FLAG_COMPRESSED = 1
+DATA_ALIGNMENT = 16
+HEADER = struct.Struct("<4sIIIQQQ")
+ENTRY = struct.Struct("<IIIIQQQ")
+STORED_EXTENSIONS = {".png", ".ogg", ".ttf"}
+
+
+def align(value, alignment):
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+def collect(root):
+    files = []
+    for directory, _, names in os.walk(root):
+        for name in names:
+            path = os.path.join(directory, name)
+            relative = os.path.relpath(path, root).replace(os.sep, "/").lower()
+            files.append((relative.encode("utf-8"), path))
+    files.sort()
+
+    for previous, current in zip(files, files[1:]):
+        if previous[0] == current[0]:
+            raise SystemExit(f"error: '{previous[1]}' and '{current[1]}' differ only in case")
+    return files
+
+
+def pack(root, output):
+    files = collect(root)
+
+    names = bytearray()
+    entries = []
+    payloads = []
+    for name, path in files:
+        with open(path, "rb") as f:
+            data = f.read()
+
+        flags = 0
+        stored = data
+        if os.path.splitext(path)[1].lower() not in STORED_EXTENSIONS:
+            compressed = zlib.compress(data, 9)
+            if len(compressed) * 10 <= len(data) * 9:
+                flags = FLAG_COMPRESSED
+                stored = compressed
+
+        entries.append([len(names), len(name), flags, len(data), len(stored)])
+        names += name
+        payloads.append(stored)
+
+    index_offset = align(HEADER.size, 8)
+    names_offset = index_offset + ENTRY.size * len(entries)
+    offset = align(names_offset + len(names), DATA_ALIGNMENT)
+
+    temp = output + ".tmp"
+    with open(temp, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, len(entries), 0, index_offset, names_offset, len(names)))
+        f.write(b"\0" * (index_offset - HEADER.size))
+        for (name_offset, name_length, flags, size, stored_size), payload in zip(entries, payloads):
+            f.write(ENTRY.pack(name_offset, name_length, flags, 0, offset, size, stored_size))
+            offset = align(offset + stored_size, DATA_ALIGNMENT)
+        f.write(names)
+        for payload in payloads:
+            f.write(b"\0" * (align(f.tell(), DATA_ALIGNMENT) - f.tell()))
+            f.write(payload)
+    os.replace(temp, output)
+
+    raw = sum(entry[3] for entry in entries)
+    print(f"Packed {len(entries)} files ({raw / 1048576:.1f} MiB) into {output} "
+          f"({os.path.getsize(output) / 1048576:.1f} MiB)")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        raise SystemExit(__doc__)
+    pack(sys.argv[1], sys.argv[2])